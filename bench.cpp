@@ -0,0 +1,534 @@
+#include "Riichi.hpp"
+
+#include "riichi/AIAgents_Standard.hpp"
+#include "riichi/HandInterpreter.hpp"
+#include "riichi/Random.hpp"
+#include "riichi/Round.hpp"
+#include "riichi/Rules_Standard.hpp"
+#include "riichi/TileCountKernels.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+
+//------------------------------------------------------------------------------
+// Hand evaluation microbenchmarks, and whole games played out between AI agents.
+// Every benchmark runs over the same seeded corpus of hands or games, and prints one line of JSON
+// with its throughput so that results can be collected and compared across releases.
+// Usage: libriichi_bench [name filter] [minimum seconds per benchmark]
+//------------------------------------------------------------------------------
+namespace Bench
+{
+
+using namespace Riichi;
+
+static constexpr unsigned int c_corpusSeed = 0x5EED;
+static constexpr size_t c_randomHandCount = 400;
+static constexpr size_t c_completeHandCount = 400;
+static constexpr size_t c_openHandCount = 200;
+static constexpr unsigned int c_gameSeed = 0x6A3E;
+static constexpr unsigned int c_aiSeedMask = 0xA1A1A1A1;
+
+//------------------------------------------------------------------------------
+// A hand of 3n+1 tiles, plus a drawn tile that it may or may not win on
+struct CorpusHand
+{
+	Hand m_hand;
+	TileDraw m_draw;
+};
+
+//------------------------------------------------------------------------------
+class CorpusBuilder
+{
+	Vector<TileInstance> m_tileSet;
+	std::mt19937 m_rng{ c_corpusSeed };
+	TileInstanceIDGenerator m_generateID;
+
+public:
+	explicit CorpusBuilder( Rules const& i_rules )
+		: m_tileSet{ i_rules.Tileset() }
+	{}
+
+	// Tiles dealt at random, which are rarely close to complete
+	CorpusHand RandomHand()
+	{
+		std::ranges::shuffle( m_tileSet, m_rng );
+		return MakeHand( Vector<TileInstance>( m_tileSet.begin(), m_tileSet.begin() + 14 ) );
+	}
+
+	// Four groups and a pair, so that the hand is waiting and the draw wins it
+	CorpusHand CompleteHand()
+	{
+		Vector<TileInstance> const tiles = CompleteTiles();
+		return MakeHand( tiles );
+	}
+
+	// As a complete hand, but with a triplet called from another player
+	CorpusHand OpenHand()
+	{
+		Vector<TileInstance> tiles;
+		size_t tripletI = 0;
+		do
+		{
+			tiles = CompleteTiles();
+			tripletI = FindTriplet( tiles );
+		} while ( tripletI == tiles.size() );
+
+		Vector<TileInstance> const triplet( tiles.begin() + tripletI, tiles.begin() + tripletI + 3 );
+		tiles.erase( tiles.begin() + tripletI, tiles.begin() + tripletI + 3 );
+		CorpusHand corpusHand = MakeHand( tiles );
+		corpusHand.m_hand.AddFreeTiles( Vector<TileInstance>{ triplet[ 1 ], triplet[ 2 ] } );
+		corpusHand.m_hand.CallMeld( triplet[ 0 ], Seat::North, triplet[ 1 ], triplet[ 2 ] );
+		return corpusHand;
+	}
+
+	// Shapes known to be expensive, written as e.g. "1112345678999m5m", with honours as 1-7z (winds then dragons)
+	CorpusHand ShapeHand( std::string_view i_tiles )
+	{
+		static constexpr Face c_honourFaces[] = { Face::East, Face::South, Face::West, Face::North, Face::Haku, Face::Hatsu, Face::Chun };
+
+		Vector<TileInstance> tiles;
+		Vector<char> faces;
+		for ( char c : i_tiles )
+		{
+			if ( c >= '1' && c <= '9' )
+			{
+				faces.push_back( c );
+				continue;
+			}
+
+			for ( char face : faces )
+			{
+				size_t const faceI = static_cast< size_t >( face - '1' );
+				TileKind const kind = c == 'z'
+					? TileKind{ c_honourFaces[ faceI ] }
+					: TileKind{ c == 'm' ? Suit::Manzu : c == 'p' ? Suit::Pinzu : Suit::Souzu, Numbers::IndexToValue( faceI ) };
+				tiles.push_back( TileInstance{ Tile{ kind }, m_generateID() } );
+			}
+			faces.clear();
+		}
+		riEnsure( tiles.size() == 14, "Shapes need 13 tiles and a draw" );
+
+		CorpusHand corpusHand{ {}, TileDraw{ tiles.back(), TileDrawType::SelfDraw } };
+		tiles.pop_back();
+		corpusHand.m_hand.AddFreeTiles( tiles );
+		return corpusHand;
+	}
+
+private:
+	// Takes a random tile as the draw, and the rest as the hand
+	CorpusHand MakeHand( Vector<TileInstance> i_tiles )
+	{
+		std::uniform_int_distribution<size_t> drawDistribution( 0, i_tiles.size() - 1 );
+		size_t const drawI = drawDistribution( m_rng );
+		CorpusHand corpusHand{ {}, TileDraw{ i_tiles[ drawI ], TileDrawType::SelfDraw } };
+		i_tiles.erase( i_tiles.begin() + drawI );
+		corpusHand.m_hand.AddFreeTiles( i_tiles );
+		return corpusHand;
+	}
+
+	Vector<TileInstance> CompleteTiles()
+	{
+		// Real tiles, so that akadora and the like turn up as they would in a game
+		std::ranges::shuffle( m_tileSet, m_rng );
+		Array<Vector<TileInstance>, TileKindIndex::c_count> pool;
+		for ( TileInstance const& tile : m_tileSet )
+		{
+			pool[ TileKindIndex{ tile.Tile() } ].push_back( tile );
+		}
+
+		Vector<TileInstance> tiles;
+		auto fnTake = [ & ]( size_t i_kindI, size_t i_count )
+		{
+			for ( size_t i = 0; i < i_count; ++i )
+			{
+				tiles.push_back( pool[ i_kindI ].back() );
+				pool[ i_kindI ].pop_back();
+			}
+		};
+
+		std::uniform_int_distribution<size_t> kindDistribution( 0, TileKindIndex::c_count - 1 );
+		std::bernoulli_distribution sequenceDistribution( 0.6 );
+		while ( tiles.size() < 12 )
+		{
+			size_t const kindI = kindDistribution( m_rng );
+			bool const canStartSequence = TileKindIndex{ kindI }.IsNumber() && kindI % Numbers::Count() < Numbers::Count() - 2;
+			if ( canStartSequence && sequenceDistribution( m_rng ) )
+			{
+				if ( !pool[ kindI ].empty() && !pool[ kindI + 1 ].empty() && !pool[ kindI + 2 ].empty() )
+				{
+					fnTake( kindI, 1 );
+					fnTake( kindI + 1, 1 );
+					fnTake( kindI + 2, 1 );
+				}
+			}
+			else if ( pool[ kindI ].size() >= 3 )
+			{
+				fnTake( kindI, 3 );
+			}
+		}
+		while ( tiles.size() < 14 )
+		{
+			size_t const kindI = kindDistribution( m_rng );
+			if ( pool[ kindI ].size() >= 2 )
+			{
+				fnTake( kindI, 2 );
+			}
+		}
+		return tiles;
+	}
+
+	// Groups are laid out one after another, so a triplet starts on a multiple of 3
+	static size_t FindTriplet( Vector<TileInstance> const& i_tiles )
+	{
+		for ( size_t groupI = 0; groupI + 3 <= 12; groupI += 3 )
+		{
+			EqualsTileKind const sharesTileKind{ i_tiles[ groupI ] };
+			if ( sharesTileKind( i_tiles[ groupI + 1 ] ) && sharesTileKind( i_tiles[ groupI + 2 ] ) )
+			{
+				return groupI;
+			}
+		}
+		return i_tiles.size();
+	}
+};
+
+//------------------------------------------------------------------------------
+static char const* KernelLevelName
+(
+	CountKernelLevel i_level
+)
+{
+	switch ( i_level )
+	{
+	case CountKernelLevel::Scalar: return "Scalar";
+	case CountKernelLevel::SSE2: return "SSE2";
+	case CountKernelLevel::AVX2: return "AVX2";
+	}
+	return "Unknown";
+}
+
+//------------------------------------------------------------------------------
+// An agent that can sit at the game tables. Any new agent just needs adding here to be benchmarked.
+struct AgentKind
+{
+	char const* m_name;
+	std::unique_ptr<AI::Agent>( *m_make )();
+};
+
+static constexpr AgentKind c_agentKinds[] = {
+	{ "Ghost", []() -> std::unique_ptr<AI::Agent> { return std::make_unique<AI::GhostAgent>(); } },
+	{ "ButtonMasher", []() -> std::unique_ptr<AI::Agent> { return std::make_unique<AI::ButtonMasherAgent>(); } },
+	{ "Efficiency", []() -> std::unique_ptr<AI::Agent> { return std::make_unique<AI::EfficiencyAgent>(); } },
+};
+
+//------------------------------------------------------------------------------
+// Four agents, one per seat in seating order
+using Lineup = Array<AgentKind const*, 4>;
+
+//------------------------------------------------------------------------------
+struct GameStats
+{
+	static constexpr size_t c_stateTypeCount = static_cast< size_t >( TableStateType::RonAKanChance ) + 1;
+
+	uint64_t m_games{ 0 };
+	uint64_t m_rounds{ 0 };
+	uint64_t m_transitions{ 0 };
+	double m_seconds{ 0.0 };
+	Array<uint64_t, c_stateTypeCount> m_stateTransitions{};
+	Array<double, c_stateTypeCount> m_stateSeconds{};
+};
+
+//------------------------------------------------------------------------------
+// Plays a whole game through the same table API the demo uses, with nobody at the table but AI.
+// Only the game itself is timed, not setting up the table.
+static void PlayGame
+(
+	std::shared_ptr<Rules const> const& i_rules,
+	unsigned int i_seed,
+	Lineup const& i_lineup,
+	GameStats& io_stats
+)
+{
+	using Clock = std::chrono::steady_clock;
+
+	Table table(
+		i_rules,
+		i_seed,
+		i_seed ^ c_aiSeedMask
+	);
+	for ( AgentKind const* agentKind : i_lineup )
+	{
+		table.AddPlayer( Player{ agentKind->m_make() } );
+	}
+
+	while ( true )
+	{
+		TableStateType const type = table.GetState().Type();
+		Clock::time_point const start = Clock::now();
+		if ( !table.AdvanceAIOnly() )
+		{
+			break;
+		}
+		if ( type == TableStateType::BetweenRounds )
+		{
+			++io_stats.m_rounds;
+		}
+		table.RetrieveEvent();
+		std::chrono::duration<double> const elapsed = Clock::now() - start;
+
+		size_t const typeI = static_cast< size_t >( type );
+		++io_stats.m_transitions;
+		++io_stats.m_stateTransitions[ typeI ];
+		io_stats.m_stateSeconds[ typeI ] += elapsed.count();
+		io_stats.m_seconds += elapsed.count();
+	}
+
+	++io_stats.m_games;
+}
+
+//------------------------------------------------------------------------------
+class Runner
+{
+	std::string_view m_filter;
+	double m_minSeconds;
+
+public:
+	Runner( std::string_view i_filter, double i_minSeconds )
+		: m_filter{ i_filter }
+		, m_minSeconds{ i_minSeconds }
+	{}
+
+	// Calls i_fn( index ) for every corpus entry, in whole passes until the minimum time is up.
+	// i_fn returns something derived from its result, summed into a checksum so that the work can't be skipped.
+	// The checksum printed is per pass over the corpus, so it should only change if results do.
+	template<typename T_Fn>
+	void Run( std::string_view i_name, size_t i_corpusSize, T_Fn&& i_fn ) const
+	{
+		if ( i_corpusSize == 0 || i_name.find( m_filter ) == std::string_view::npos )
+		{
+			return;
+		}
+
+		using Clock = std::chrono::steady_clock;
+
+		// One untimed pass first to warm up caches and lazily built tables
+		uint64_t checksum = 0;
+		for ( size_t i = 0; i < i_corpusSize; ++i )
+		{
+			checksum += i_fn( i );
+		}
+
+		checksum = 0;
+		uint64_t ops = 0;
+		Clock::time_point const start = Clock::now();
+		std::chrono::duration<double> elapsed{ 0 };
+		do
+		{
+			for ( size_t i = 0; i < i_corpusSize; ++i )
+			{
+				checksum += i_fn( i );
+			}
+			ops += i_corpusSize;
+			elapsed = Clock::now() - start;
+		} while ( elapsed.count() < m_minSeconds );
+
+		double const seconds = elapsed.count();
+		std::cout << "{\"benchmark\":\"" << i_name << "\""
+			<< ",\"corpus\":" << i_corpusSize
+			<< ",\"ops\":" << ops
+			<< ",\"seconds\":" << seconds
+			<< ",\"ns_per_op\":" << ( seconds * 1e9 / static_cast< double >( ops ) )
+			<< ",\"ops_per_sec\":" << ( static_cast< double >( ops ) / seconds )
+			<< ",\"count_kernels\":\"" << KernelLevelName( CountKernels::ActiveLevel() ) << "\""
+			<< ",\"checksum\":" << ( checksum / ( ops / i_corpusSize ) )
+			<< "}" << std::endl;
+	}
+
+	// Plays games seeded one after another from c_gameSeed until the minimum time is up,
+	// so a longer run plays the same games as a shorter one and then some more.
+	template<Seat t_GameLength>
+	void RunGames( std::string_view i_name, Lineup const& i_lineup ) const
+	{
+		if ( i_name.find( m_filter ) == std::string_view::npos )
+		{
+			return;
+		}
+
+		std::shared_ptr<Rules const> const rules = std::make_shared<StandardYonma<t_GameLength>>();
+		GameStats stats;
+		do
+		{
+			PlayGame( rules, c_gameSeed + static_cast< unsigned int >( stats.m_games ), i_lineup, stats );
+		} while ( stats.m_seconds < m_minSeconds );
+
+		std::cout << "{\"benchmark\":\"" << i_name << "\""
+			<< ",\"games\":" << stats.m_games
+			<< ",\"rounds\":" << stats.m_rounds
+			<< ",\"transitions\":" << stats.m_transitions
+			<< ",\"seconds\":" << stats.m_seconds
+			<< ",\"games_per_sec\":" << ( static_cast< double >( stats.m_games ) / stats.m_seconds )
+			<< ",\"rounds_per_sec\":" << ( static_cast< double >( stats.m_rounds ) / stats.m_seconds )
+			<< ",\"transitions_per_sec\":" << ( static_cast< double >( stats.m_transitions ) / stats.m_seconds )
+			<< ",\"count_kernels\":\"" << KernelLevelName( CountKernels::ActiveLevel() ) << "\""
+			<< ",\"states\":{";
+		char const* separator = "";
+		for ( size_t typeI = 0; typeI < GameStats::c_stateTypeCount; ++typeI )
+		{
+			std::cout << separator << "\"" << ToString( static_cast< TableStateType >( typeI ) ) << "\":{"
+				<< "\"transitions\":" << stats.m_stateTransitions[ typeI ]
+				<< ",\"seconds\":" << stats.m_stateSeconds[ typeI ]
+				<< ",\"share\":" << ( stats.m_stateSeconds[ typeI ] / stats.m_seconds )
+				<< "}";
+			separator = ",";
+		}
+		std::cout << "}}" << std::endl;
+	}
+};
+
+}
+
+int main( int argc, char** argv )
+{
+	using namespace Riichi;
+	using namespace Bench;
+
+	Runner const runner{ argc > 1 ? argv[ 1 ] : "", argc > 2 ? std::atof( argv[ 2 ] ) : 0.5 };
+
+	StandardYonma<Seat::East> rules;
+	Vector<PlayerID> const players{ PlayerID{}, PlayerID{}, PlayerID{}, PlayerID{} };
+	ShuffleRNG shuffleRNG( c_corpusSeed );
+	Round const round( Seat::East, players, rules, shuffleRNG );
+
+	// Build the corpus
+	CorpusBuilder builder( rules );
+	Vector<CorpusHand> corpus;
+	for ( size_t i = 0; i < c_randomHandCount; ++i )
+	{
+		corpus.push_back( builder.RandomHand() );
+	}
+	for ( size_t i = 0; i < c_completeHandCount; ++i )
+	{
+		corpus.push_back( builder.CompleteHand() );
+	}
+	for ( size_t i = 0; i < c_openHandCount; ++i )
+	{
+		corpus.push_back( builder.OpenHand() );
+	}
+	// Nine gates
+	corpus.push_back( builder.ShapeHand( "1112345678999m5m" ) );
+	corpus.push_back( builder.ShapeHand( "1112345678999p1p" ) );
+	// Thirteen orphans
+	corpus.push_back( builder.ShapeHand( "19m19p19s1234567z1m" ) );
+	// Seven pairs
+	corpus.push_back( builder.ShapeHand( "1133m2255p7799s11z" ) );
+	// Many interpretations
+	corpus.push_back( builder.ShapeHand( "1112223334445m5m" ) );
+	corpus.push_back( builder.ShapeHand( "2223334445556p6p" ) );
+	corpus.push_back( builder.ShapeHand( "1122233399555m9m" ) );
+	// Sequence or triplet
+	corpus.push_back( builder.ShapeHand( "111234567m666p7s7s" ) );
+
+	Vector<HandAssessment> assessments;
+	Vector<size_t> winningHands;
+	for ( size_t i = 0; i < corpus.size(); ++i )
+	{
+		HandAssessment const& assessment = assessments.emplace_back( corpus[ i ].m_hand, rules );
+		if ( assessment.Waits().Contains( corpus[ i ].m_draw.m_tile.Tile() ) )
+		{
+			winningHands.push_back( i );
+		}
+	}
+
+	// Hand evaluation
+	runner.Run( "HandAssessment", corpus.size(), [ & ]( size_t i_index )
+	{
+		return HandAssessment( corpus[ i_index ].m_hand, rules ).Interpretations().size();
+	} );
+
+	for ( HandInterpreter const& interpreter : rules.Interpreters() )
+	{
+		Vector<HandInterpretation> fixedParts;
+		Vector<TileCounts> freeTiles;
+		for ( CorpusHand const& corpusHand : corpus )
+		{
+			HandInterpretation& fixedPart = fixedParts.emplace_back();
+			fixedPart.m_interpreter = interpreter.ID();
+			for ( Meld const& meld : corpusHand.m_hand.Melds() )
+			{
+				HandGroup::GroupTiles meldTiles;
+				for ( TileInstance const& tile : meld.Tiles() )
+				{
+					meldTiles.push_back( tile.Tile() );
+				}
+				// Same group type the assessment gives each meld, where upgraded quads count as quads
+				GroupType const type = meld.Sequence() ? GroupType::Sequence : meld.Quad() ? GroupType::Quad : GroupType::Triplet;
+				fixedPart.m_groups.emplace_back( meldTiles, type, meld.Open() );
+			}
+			freeTiles.push_back( corpusHand.m_hand.FreeTileCounts() );
+		}
+
+		runner.Run( std::string( "Interpreter/" ) + interpreter.Name(), corpus.size(), [ & ]( size_t i_index )
+		{
+			return interpreter.GenerateInterpretations( fixedParts[ i_index ], freeTiles[ i_index ] ).size();
+		} );
+	}
+
+	for ( bool considerForRiichi : { false, true } )
+	{
+		runner.Run( considerForRiichi ? "WaitsWithYaku/Riichi" : "WaitsWithYaku", corpus.size(), [ & ]( size_t i_index )
+		{
+			auto const [ waits, riichiDiscards ] = rules.WaitsWithYaku( round, Seat::East, corpus[ i_index ].m_hand, assessments[ i_index ], corpus[ i_index ].m_draw, considerForRiichi );
+			return waits.Size() + riichiDiscards.size();
+		} );
+	}
+
+	runner.Run( "CalculateBasicPoints", winningHands.size(), [ & ]( size_t i_index )
+	{
+		size_t const handI = winningHands[ i_index ];
+		return static_cast< size_t >( rules.CalculateBasicPoints( round, Seat::East, corpus[ handI ].m_hand, assessments[ handI ], corpus[ handI ].m_draw ).m_basicPoints );
+	} );
+
+	// Call options, all asked about the drawn tile
+	runner.Run( "ChiOptions", corpus.size(), [ & ]( size_t i_index )
+	{
+		return corpus[ i_index ].m_hand.ChiOptions( corpus[ i_index ].m_draw.m_tile.Tile() ).size();
+	} );
+	runner.Run( "PonOptions", corpus.size(), [ & ]( size_t i_index )
+	{
+		return corpus[ i_index ].m_hand.PonOptions( corpus[ i_index ].m_draw.m_tile.Tile() ).size();
+	} );
+	runner.Run( "KanOptions", corpus.size(), [ & ]( size_t i_index )
+	{
+		return corpus[ i_index ].m_hand.KanOptions( corpus[ i_index ].m_draw.m_tile.Tile() ).size();
+	} );
+	runner.Run( "HandKanOptions", corpus.size(), [ & ]( size_t i_index )
+	{
+		return corpus[ i_index ].m_hand.HandKanOptions( corpus[ i_index ].m_draw.m_tile ).size();
+	} );
+
+	// Whole games, first with everyone playing the same agent, then with a mix of them all
+	Vector<Pair<std::string, Lineup>> lineups;
+	for ( AgentKind const& agentKind : c_agentKinds )
+	{
+		lineups.emplace_back( agentKind.m_name, Lineup{ &agentKind, &agentKind, &agentKind, &agentKind } );
+	}
+	Lineup mixed;
+	for ( size_t seatI = 0; seatI < mixed.size(); ++seatI )
+	{
+		mixed[ seatI ] = &c_agentKinds[ seatI % std::size( c_agentKinds ) ];
+	}
+	lineups.emplace_back( "Mixed", mixed );
+
+	for ( auto const& [ lineupName, lineup ] : lineups )
+	{
+		runner.RunGames<Seat::East>( "Game/Tonpuusen/" + lineupName, lineup );
+		runner.RunGames<Seat::South>( "Game/Hanchan/" + lineupName, lineup );
+	}
+
+	return 0;
+}
@@ -437,16 +437,17 @@ int main()
 			Riichi::TableEvents::Tsumo const& tsumo = event.Get<Tsumo>();
 			Riichi::Round::WinScores const& scores = table.GetRound().WinnerScores( tsumo.Winner() ).value();
 			std::cout << Riichi::ToString( tsumo.Winner() ) << " won with tsumo! Score:\n";
-			for ( auto const& yaku : scores.m_handScore.m_yaku )
+			for ( Riichi::YakuID yaku : scores.m_handScore.m_yaku.IDs() )
 			{
-				std::cout << yaku.first << ": ";
-				if ( yaku.second.IsYakuman() )
+				Riichi::HanValue const value = scores.m_handScore.m_yaku.Value( yaku );
+				std::cout << table.GetRules().YakuName( yaku ) << ": ";
+				if ( value.IsYakuman() )
 				{
 					std::cout << "yakuman";
 				}
 				else
 				{
-					std::cout << static_cast< int >( yaku.second.Get() );
+					std::cout << static_cast< int >( value.Get() );
 				}
 				std::cout << "\n";
 			}
@@ -463,16 +464,17 @@ int main()
 			{
 				Riichi::Round::WinScores const& scores = table.GetRound().WinnerScores( winner ).value();
 				std::cout << Riichi::ToString( winner ) << " won with ron! Score:\n";
-				for ( auto const& yaku : scores.m_handScore.m_yaku )
+				for ( Riichi::YakuID yaku : scores.m_handScore.m_yaku.IDs() )
 				{
-					std::cout << yaku.first << ": ";
-					if ( yaku.second.IsYakuman() )
+					Riichi::HanValue const value = scores.m_handScore.m_yaku.Value( yaku );
+					std::cout << table.GetRules().YakuName( yaku ) << ": ";
+					if ( value.IsYakuman() )
 					{
 						std::cout << "yakuman";
 					}
 					else
 					{
-						std::cout << static_cast< int >( yaku.second.Get() );
+						std::cout << static_cast< int >( value.Get() );
 					}
 					std::cout << "\n";
 				}
@@ -147,7 +147,7 @@ int main()
 		bool const hasWaits = std::ranges::find_if( ass.Interpretations(),
 			[]( HandInterpretation const& i_i ) -> bool
 			{
-				return !i_i.m_waits.empty();
+				return !i_i.m_waits.Empty();
 			}
 		) != ass.Interpretations().end();
 		if ( unequalGroups && hasWaits )
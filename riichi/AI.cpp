@@ -11,6 +11,32 @@ StrategyAgent::StrategyAgent( T_Strategies... i_strategies )
 {
 }
 
+//------------------------------------------------------------------------------
+std::unique_ptr<Agent> StrategyAgent::Clone
+(
+)	const
+{
+	Vector<std::unique_ptr<Strategy>> strategies;
+	strategies.reserve( m_strategies.size() );
+	Strategy* mostRecentlyUsedStrategy = nullptr;
+	for ( std::unique_ptr<Strategy> const& strategy : m_strategies )
+	{
+		strategies.push_back( strategy->Clone() );
+		if ( !strategies.back() )
+		{
+			return nullptr;
+		}
+		if ( strategy.get() == m_mostRecentlyUsedStrategy )
+		{
+			mostRecentlyUsedStrategy = strategies.back().get();
+		}
+	}
+
+	std::unique_ptr<StrategyAgent> clone( new StrategyAgent( std::move( strategies ) ) );
+	clone->m_mostRecentlyUsedStrategy = mostRecentlyUsedStrategy;
+	return clone;
+}
+
 //------------------------------------------------------------------------------
 TurnDecisionData StrategyAgent::MakeTurnDecision
 (
@@ -8,6 +8,8 @@
 #include "Tile.hpp"
 #include "Utils.hpp"
 
+#include <memory>
+
 namespace Riichi::TableStates
 {
 struct BaseTurn;
@@ -76,6 +78,10 @@ struct Agent
 {
 	virtual ~Agent() = default;
 
+	// An independent copy, including any decision still in progress, for when a table is forked.
+	// Opt-in: agents that don't override this can't be forked, and nor can any table they play at.
+	virtual std::unique_ptr<Agent> Clone() const { return nullptr; }
+
 	virtual TurnDecisionData MakeTurnDecision
 	(
 		DecisionToken i_token,
@@ -110,6 +116,9 @@ struct Strategy
 
 	virtual ~Strategy() = default;
 
+	// As for Agent::Clone(), returning null if the strategy can't be cloned
+	virtual std::unique_ptr<Strategy> Clone() const { return nullptr; }
+
 	virtual Pair<TurnDecisionData, Strength> MakeTurnDecision
 	(
 		DecisionToken i_token,
@@ -146,6 +155,8 @@ struct StrategyAgent
 	{
 	}
 
+	std::unique_ptr<Agent> Clone() const override;
+
 	TurnDecisionData MakeTurnDecision
 	(
 		DecisionToken i_token,
@@ -165,6 +176,12 @@ struct StrategyAgent
 		Round const& i_round,
 		TableStates::BetweenTurns const& i_turnData
 	) override;
+
+protected:
+	explicit StrategyAgent( Vector<std::unique_ptr<Strategy>> i_strategies )
+		: m_strategies{ std::move( i_strategies ) }
+	{
+	}
 };
 
 }
\ No newline at end of file
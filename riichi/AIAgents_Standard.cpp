@@ -1,5 +1,7 @@
 ﻿#include "AIAgents_Standard.hpp"
 
+#include "Shanten.hpp"
+
 namespace Riichi::AI
 {
 
@@ -111,4 +113,89 @@ BetweenTurnsDecisionData ButtonMasherAgent::MakeBetweenTurnsDecision
 	return { BetweenTurnsDecisionData::Tag<BetweenTurnsDecision::Pass>() };
 }
 
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+TurnDecisionData EfficiencyAgent::MakeTurnDecision
+(
+	DecisionToken i_token,
+	AIRNG& io_rng,
+	Seat i_agentSeat,
+	Riichi::Table const& i_table,
+	Riichi::Round const& i_round,
+	Riichi::TableStates::Turn_AI const& i_turnData
+)
+{
+	if ( i_turnData.CanTsumo() )
+	{
+		return { TurnDecisionData::Tag<TurnDecision::Tsumo>() };
+	}
+
+	Option<TileInstance> const tileDraw = i_turnData.GetCurrentTileDraw();
+	if ( i_turnData.IsRiichi() )
+	{
+		return { TurnDecisionData::Tag<TurnDecision::Discard>(), std::nullopt };
+	}
+
+	Vector<TileInstance> candidates = i_turnData.GetCurrentHand().FreeTiles();
+	if ( tileDraw )
+	{
+		candidates.push_back( *tileDraw );
+	}
+
+	// With several copies of the best kind, let the drawn tile go first and keep hold of akadora
+	auto fnPickCopy = [ & ]( TileKindIndex i_kind ) -> Option<TileInstance>
+	{
+		Option<TileInstance> best;
+		auto fnScore = [ & ]( TileInstance const& i_tile ) { return ( i_tile.Tile().HasProperty<Akadora>() ? 2 : 0 ) + ( tileDraw && i_tile.ID() == tileDraw->ID() ? 0 : 1 ); };
+		for ( TileInstance const& tile : candidates )
+		{
+			if ( TileKindIndex{ tile.Tile() } == i_kind && ( !best || fnScore( tile ) < fnScore( *best ) ) )
+			{
+				best = tile;
+			}
+		}
+		return best;
+	};
+	auto fnAsHandTile = [ & ]( TileInstance const& i_tile ) { return tileDraw && i_tile.ID() == tileDraw->ID() ? Option<TileInstance>() : Option<TileInstance>( i_tile ); };
+
+	Vector<DiscardOption> const ranked = RankDiscards( i_turnData.GetCurrentHand(), tileDraw, i_round.VisibleTileCounts( i_agentSeat ) );
+	riEnsure( !ranked.empty(), "Hand had nothing to discard" );
+
+	if ( i_turnData.CanRiichi() )
+	{
+		// Every riichi discard leaves the hand in tenpai, so go with whichever waits on the most tiles
+		candidates = i_turnData.RiichiOptions();
+		for ( DiscardOption const& option : ranked )
+		{
+			if ( Option<TileInstance> const riichiTile = fnPickCopy( option.m_discard ) )
+			{
+				return { TurnDecisionData::Tag<TurnDecision::Riichi>(), fnAsHandTile( *riichiTile ) };
+			}
+		}
+	}
+
+	Option<TileInstance> const discard = fnPickCopy( ranked.front().m_discard );
+	riEnsure( discard.has_value(), "Ranked a discard that isn't in the hand" );
+	return { TurnDecisionData::Tag<TurnDecision::Discard>(), fnAsHandTile( *discard ) };
+}
+
+//------------------------------------------------------------------------------
+BetweenTurnsDecisionData EfficiencyAgent::MakeBetweenTurnsDecision
+(
+	DecisionToken i_token,
+	AIRNG& io_rng,
+	Seat i_agentSeat,
+	Table const& i_table,
+	Round const& i_round,
+	TableStates::BetweenTurns const& i_turnData
+)
+{
+	if ( i_turnData.CanRon().Contains( i_agentSeat ) )
+	{
+		return { BetweenTurnsDecisionData::Tag<BetweenTurnsDecision::Ron>() };
+	}
+
+	return { BetweenTurnsDecisionData::Tag<BetweenTurnsDecision::Pass>() };
+}
+
 }
\ No newline at end of file
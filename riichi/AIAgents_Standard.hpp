@@ -15,6 +15,8 @@ namespace Riichi::AI
 struct GhostAgent
 	: public Agent
 {
+	std::unique_ptr<Agent> Clone() const override { return std::make_unique<GhostAgent>( *this ); }
+
 	TurnDecisionData MakeTurnDecision
 	(
 		DecisionToken i_token,
@@ -43,6 +45,38 @@ struct GhostAgent
 struct ButtonMasherAgent
 	: public Agent
 {
+	std::unique_ptr<Agent> Clone() const override { return std::make_unique<ButtonMasherAgent>( *this ); }
+
+	TurnDecisionData MakeTurnDecision
+	(
+		DecisionToken i_token,
+		AIRNG& io_rng,
+		Seat i_agentSeat,
+		Riichi::Table const& i_table,
+		Riichi::Round const& i_round,
+		Riichi::TableStates::Turn_AI const& i_turnData
+	) override;
+
+	BetweenTurnsDecisionData MakeBetweenTurnsDecision
+	(
+		DecisionToken i_token,
+		AIRNG& io_rng,
+		Seat i_agentSeat,
+		Table const& i_table,
+		Round const& i_round,
+		TableStates::BetweenTurns const& i_turnData
+	) override;
+};
+
+//------------------------------------------------------------------------------
+// Plays purely for speed, discarding whatever leaves the most live tiles that would advance the hand.
+// Riichis and wins whenever it can, but never calls as it has no idea which hands have yaku.
+//------------------------------------------------------------------------------
+struct EfficiencyAgent
+	: public Agent
+{
+	std::unique_ptr<Agent> Clone() const override { return std::make_unique<EfficiencyAgent>( *this ); }
+
 	TurnDecisionData MakeTurnDecision
 	(
 		DecisionToken i_token,
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "InplaceVector.hpp"
+
 #include <array>
 #include <optional>
 #include <span>
@@ -22,6 +24,9 @@ using Array = std::array<T, S>;
 template<typename T>
 using Option = std::optional<T>;
 
+template<typename T, size_t S>
+using InplaceVector = Utils::InplaceVector<T, S>;
+
 template<typename K, typename V>
 using Map = std::unordered_map<K, V>;
 
@@ -18,10 +18,16 @@ enum class GroupType : EnumValueType;
 class Meld;
 class Hand;
 enum class WaitType : EnumValueType;
+struct HandFeatures;
 struct HandInterpretation;
 class HandGroup;
 struct HandAssessment;
 
+//------------------------------------------------------------------------------
+// HandEvaluationCache
+//------------------------------------------------------------------------------
+class HandEvaluationCache;
+
 //------------------------------------------------------------------------------
 // HandInterpreter
 //------------------------------------------------------------------------------
@@ -57,6 +63,20 @@ struct Rules;
 //------------------------------------------------------------------------------
 enum class Seat : EnumValueType;
 
+//------------------------------------------------------------------------------
+// Shanten
+//------------------------------------------------------------------------------
+enum class ShantenForm : EnumValueType;
+
+//------------------------------------------------------------------------------
+// Simulator
+//------------------------------------------------------------------------------
+struct SimulationSeeds;
+struct GameResult;
+struct SimulationAggregator;
+struct SimulationSummary;
+class Simulator;
+
 //------------------------------------------------------------------------------
 // Table
 //------------------------------------------------------------------------------
@@ -103,6 +123,16 @@ enum class Suit : EnumValueType;
 enum class TileDrawType : EnumValueType;
 struct TileDraw;
 
+//------------------------------------------------------------------------------
+// TileCounts
+//------------------------------------------------------------------------------
+class TileCounts;
+
+//------------------------------------------------------------------------------
+// TileKindSet
+//------------------------------------------------------------------------------
+class TileKindSet;
+
 //------------------------------------------------------------------------------
 // Utils
 //------------------------------------------------------------------------------
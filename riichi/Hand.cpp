@@ -1,6 +1,7 @@
 #include "Hand.hpp"
 
 #include "HandInterpreter.hpp"
+#include "Random.hpp"
 #include "Rules.hpp"
 #include "Utils.hpp"
 
@@ -18,11 +19,107 @@ void Hand::Discard
 {
 	bool const success = Utils::EraseOneIf( m_freeTiles, EqualsTileInstanceID{ i_toDiscard } );
 	riEnsure( success, "Failed to discard tile - invalid?" );
+	m_key -= TileKey( i_toDiscard.Tile() );
 
 	if ( i_drawToAdd.has_value() )
 	{
-		m_freeTiles.push_back( i_drawToAdd.value().m_tile );
-		std::sort( m_freeTiles.begin(), m_freeTiles.end(), CompareTileKindOp{} ); // TODO-QOL: players may not always want their hand sorted
+		m_key += TileKey( i_drawToAdd.value().m_tile.Tile() );
+		InsertFreeTile( i_drawToAdd.value().m_tile ); // TODO-QOL: players may not always want their hand sorted
+	}
+}
+
+//------------------------------------------------------------------------------
+void Hand::RemoveFreeTile
+(
+	TileInstance const& i_tile
+)
+{
+	[[maybe_unused]] bool const success = Utils::EraseOneIf( m_freeTiles, EqualsTileInstanceID{ i_tile } );
+	riEnsure( success, "Failed to remove tile - invalid?" );
+	m_key -= TileKey( i_tile.Tile() );
+}
+
+//------------------------------------------------------------------------------
+void Hand::UndoDiscard
+(
+	TileInstance const& i_discarded,
+	size_t i_discardedIndex,
+	Option<TileDraw> const& i_drawAdded
+)
+{
+	if ( i_drawAdded.has_value() )
+	{
+		RemoveFreeTile( i_drawAdded.value().m_tile );
+	}
+
+	riEnsure( i_discardedIndex <= m_freeTiles.size(), "Discarded tile can't have come from past the end of the hand" );
+	m_freeTiles.insert( m_freeTiles.begin() + i_discardedIndex, i_discarded );
+	m_key += TileKey( i_discarded.Tile() );
+}
+
+//------------------------------------------------------------------------------
+void Hand::UndoMeld
+(
+	FreeTileIndices const& i_from
+)
+{
+	riEnsure( !m_melds.empty(), "No meld to undo" );
+
+	Meld const& meld = m_melds.back();
+	m_key -= MeldKey( meld );
+	RestoreFreeTiles( meld.m_tilesFromHand, i_from );
+	m_melds.pop_back();
+}
+
+//------------------------------------------------------------------------------
+void Hand::UndoUpgradedQuad
+(
+	TileInstance const& i_upgradeTile,
+	FreeTileIndices const& i_from
+)
+{
+	auto const meldI = std::ranges::find_if( m_melds,
+		[ & ]( Meld const& meld ) { return meld.UpgradedQuad() && meld.UpgradedQuadTile().ID() == i_upgradeTile.ID(); }
+	);
+	riEnsure( meldI != m_melds.end(), "Failed to find upgraded quad to undo" );
+
+	m_key -= MeldKey( *meldI );
+	meldI->m_tilesFromHand.pop_back();
+	m_key += MeldKey( *meldI );
+
+	// The upgrade tile only goes back into the free tiles if it came from there, rather than being the drawn tile
+	RestoreFreeTiles( { i_upgradeTile }, i_from );
+}
+
+//------------------------------------------------------------------------------
+void Hand::RestoreFreeTiles
+(
+	Meld::TilesFromHand const& i_tiles,
+	FreeTileIndices const& i_from
+)
+{
+	// Tiles are matched up with their indices in order, with any tiles beyond the indices not having come from the free tiles.
+	// Putting them back lowest index first means each index is already correct by the time it is inserted at.
+	riEnsure( i_from.size() <= i_tiles.size(), "More indices than tiles to restore" );
+
+	// At most four, so a plain insertion sort of the positions does
+	Array<uint8_t, 4> order{};
+	for ( uint8_t i = 0; i < i_from.size(); ++i )
+	{
+		uint8_t insertI = i;
+		for ( ; insertI > 0 && i_from[ order[ insertI - 1u ] ] > i_from[ i ]; --insertI )
+		{
+			order[ insertI ] = order[ insertI - 1u ];
+		}
+		order[ insertI ] = i;
+	}
+
+	for ( size_t orderI = 0; orderI < i_from.size(); ++orderI )
+	{
+		uint8_t const i = order[ orderI ];
+		riEnsure( i_from[ i ] <= m_freeTiles.size(), "Free tile can't have come from past the end of the hand" );
+		m_freeTiles.insert( m_freeTiles.begin() + i_from[ i ], i_tiles[ i ] );
+		m_key += TileKey( i_tiles[ i ].Tile() );
 	}
 }
 
@@ -47,19 +144,32 @@ Vector<ChiOption> Hand::ChiOptions
 	Set<TileInstance, EqualsTileInstanceIDOp> tiles1;
 	Set<TileInstance, EqualsTileInstanceIDOp> tiles2;
 
-	auto fnSearchForTiles = [ & ]( TileKind const& i_search1, TileKind const& i_search2 )
+	// Index every free tile once, so each shape is only integer compares
+	TileCounts const counts = FreeTileCounts();
+	Vector<TileKindIndex> freeKinds;
+	freeKinds.reserve( m_freeTiles.size() );
+	for ( TileInstance const& tile : m_freeTiles )
 	{
-		EqualsTileKind const sharesSearch1Kind{ i_search1 };
-		EqualsTileKind const sharesSearch2Kind{ i_search2 };
-		for ( TileInstance const& tile : m_freeTiles )
+		freeKinds.push_back( tile.Tile() );
+	}
+
+	auto fnSearchForTiles = [ & ]( TileKindIndex i_search1, TileKindIndex i_search2 )
+	{
+		if ( counts[ i_search1 ] == 0 || counts[ i_search2 ] == 0 )
+		{
+			// Shape can't be made, no need to look for instances
+			return;
+		}
+
+		for ( size_t tileI = 0; tileI < m_freeTiles.size(); ++tileI )
 		{
-			if ( sharesSearch1Kind( tile ) )
+			if ( freeKinds[ tileI ] == i_search1 )
 			{
-				tiles1.insert( tile );
+				tiles1.insert( m_freeTiles[ tileI ] );
 			}
-			else if ( sharesSearch2Kind( tile ) )
+			else if ( freeKinds[ tileI ] == i_search2 )
 			{
-				tiles2.insert( tile );
+				tiles2.insert( m_freeTiles[ tileI ] );
 			}
 		}
 
@@ -79,19 +189,20 @@ Vector<ChiOption> Hand::ChiOptions
 		tiles2.clear();
 	};
 
+	TileKindIndex const tile{ i_tile };
 	if ( i_tile.Face() <= Face::Seven )
 	{
-		fnSearchForTiles( i_tile.Next(), i_tile.Next().Next() );
+		fnSearchForTiles( tile.Next(), tile.Next().Next() );
 	}
 
-	if ( i_tile.Face() >= Face::Two && i_tile.Face() <= Face::Eight )
+	if ( tile.IsSimple() )
 	{
-		fnSearchForTiles( i_tile.Prev(), i_tile.Next() );
+		fnSearchForTiles( tile.Prev(), tile.Next() );
 	}
 
 	if ( i_tile.Face() >= Face::Three )
 	{
-		fnSearchForTiles( i_tile.Prev().Prev(), i_tile.Prev() );
+		fnSearchForTiles( tile.Prev().Prev(), tile.Prev() );
 	}
 
 	return options;
@@ -234,6 +345,35 @@ Vector<HandKanOption> Hand::HandKanOptions
 	return results;
 }
 
+//------------------------------------------------------------------------------
+/*static*/ uint64_t Hand::TileKey
+(
+	Tile const& i_tile
+)
+{
+	uint64_t const tileValue = ( uint64_t{ TileKindIndex{ i_tile } } << 8 ) | i_tile.Bits();
+	return SplitMix64Finalise( tileValue + 1 );
+}
+
+//------------------------------------------------------------------------------
+/*static*/ uint64_t Hand::MeldKey
+(
+	Meld const& i_meld
+)
+{
+	// Melds are keyed as a whole (in a separate space to free tiles), since the same tiles grouped differently are a different hand
+	uint64_t key = SplitMix64Finalise( 0x4d454c44ull // "MELD"
+		^ ( uint64_t{ static_cast< EnumValueType >( i_meld.AssessmentType() ) } << 32 )
+		^ ( uint64_t{ i_meld.Open() } << 40 )
+		^ ( i_meld.Open() ? uint64_t{ static_cast< EnumValueType >( i_meld.CalledTileFrom() ) + 1u } << 48 : 0 )
+	);
+	for ( TileInstance const& tile : i_meld.Tiles() )
+	{
+		key = SplitMix64Finalise( key + TileKey( tile.Tile() ) );
+	}
+	return key;
+}
+
 //------------------------------------------------------------------------------
 std::ostream& operator<<( std::ostream& io_out, Hand const& i_hand )
 {
@@ -295,11 +435,11 @@ std::ostream& operator<<( std::ostream& io_out, Hand const& i_hand )
 //------------------------------------------------------------------------------
 HandGroup::HandGroup
 (
-	Vector<Tile> i_tiles,
+	GroupTiles const& i_tiles,
 	GroupType i_type,
 	bool i_open
 )
-	: m_tiles( std::move( i_tiles ) )
+	: m_tiles( i_tiles )
 	, m_type{ i_type }
 	, m_open{ i_open }
 {
@@ -350,7 +490,7 @@ HandGroup::HandGroup
 	Tile i_winningTile
 )
 	: HandGroup(
-		Utils::Append( i_interp.m_ungrouped, i_winningTile ),
+		Utils::Append( GroupTiles{ i_interp.m_ungrouped.begin(), i_interp.m_ungrouped.end() }, i_winningTile ),
 		WaitTypeToGroupType( i_interp.m_waitType ),
 		false
 	)
@@ -398,11 +538,95 @@ Face HandGroup::CommonNumber
 	return ( *this )[ 0 ].Face();
 }
 
+//------------------------------------------------------------------------------
+void HandFeatures::Summarise
+(
+	HandInterpretation const& i_interp
+)
+{
+	*this = HandFeatures{};
+
+	for ( HandGroup const& group : i_interp.m_groups )
+	{
+		bool hasHonourOrTerminal = false;
+		bool hasTerminal = false;
+		size_t lowestKind = TileKindIndex::c_count;
+		for ( Tile const& tile : group.Tiles() )
+		{
+			TileKindIndex const kind = tile;
+			hasHonourOrTerminal |= kind.IsHonourOrTerminal();
+			hasTerminal |= kind.IsTerminal();
+			lowestKind = std::min< size_t >( lowestKind, kind );
+		}
+
+		m_allSimples &= !hasHonourOrTerminal;
+		m_groupsAllHaveHonourOrTerminal &= hasHonourOrTerminal;
+		m_groupsAllHaveTerminal &= hasTerminal;
+
+		if ( group.Type() == GroupType::Sequence )
+		{
+			uint64_t const startBit = uint64_t{ 1 } << lowestKind;
+			m_repeatedSequenceStarts |= m_sequenceStarts & startBit;
+			m_sequenceStarts |= startBit;
+			++m_sequenceCount;
+		}
+		else if ( !group.Open() && ConsiderLikeTriplet( group.Type() ) )
+		{
+			++m_concealedTripletCount;
+		}
+	}
+
+	for ( Tile const& tile : i_interp.m_ungrouped )
+	{
+		TileKindIndex const kind = tile;
+		m_ungroupedHasHonourOrTerminal |= kind.IsHonourOrTerminal();
+		m_ungroupedHasTerminal |= kind.IsTerminal();
+	}
+	m_allSimples &= !m_ungroupedHasHonourOrTerminal;
+}
+
 //------------------------------------------------------------------------------
 HandAssessment::HandAssessment
 (
 	Hand const& i_hand,
 	Rules const& i_rules
+)
+	: HandAssessment( i_hand, i_hand.FreeTileCounts(), i_rules )
+{
+	m_handKey = i_hand.Key();
+}
+
+//------------------------------------------------------------------------------
+// Masks of TileKindIndex bits, for picking kinds out of TileCounts::KindMask
+template<typename T_Predicate>
+static constexpr uint64_t KindMaskWhere
+(
+	T_Predicate&& i_predicate
+)
+{
+	uint64_t mask = 0;
+	for ( size_t kindI = 0; kindI < TileKindIndex::c_count; ++kindI )
+	{
+		if ( i_predicate( TileKindIndex{ kindI } ) )
+		{
+			mask |= uint64_t{ 1 } << kindI;
+		}
+	}
+	return mask;
+}
+
+static constexpr uint64_t c_oneSuitMask = ( uint64_t{ 1 } << Numbers::Count() ) - 1;
+static constexpr uint64_t c_simplesMask = KindMaskWhere( []( TileKindIndex i_kind ) { return i_kind.IsSimple(); } );
+static constexpr uint64_t c_terminalsMask = KindMaskWhere( []( TileKindIndex i_kind ) { return i_kind.IsTerminal(); } );
+static constexpr uint64_t c_dragonsMask = KindMaskWhere( []( TileKindIndex i_kind ) { return i_kind.IsDragon(); } );
+static constexpr uint64_t c_windsMask = KindMaskWhere( []( TileKindIndex i_kind ) { return i_kind.IsWind(); } );
+
+//------------------------------------------------------------------------------
+HandAssessment::HandAssessment
+(
+	Hand const& i_hand,
+	TileCounts const& i_freeTileCounts,
+	Rules const& i_rules
 )
 {
 	// Make any meld-specific assessments
@@ -412,47 +636,54 @@ HandAssessment::HandAssessment
 	}
 
 	// Now assess individual tiles
-	for (TileInstance const& tile : i_hand.AllTiles() )
+	m_freeTileCounts = i_freeTileCounts;
+	m_allTileCounts = m_freeTileCounts;
+	for ( Meld const& meld : i_hand.Melds() )
 	{
-		if ( tile.Tile().IsNumber() )
+		for ( TileInstance const& tile : meld.Tiles() )
 		{
-			m_containsSuitSimples[ tile.Tile().Suit() ] |= tile.Tile().IsSimple();
-			m_containsSuitTerminals[ tile.Tile().Suit() ] |= tile.Tile().IsTerminal();
-		}
-		else
-		{
-			m_containsDragons |= tile.Tile().IsDragon();
-			m_containsWinds |= tile.Tile().IsWind();
+			m_allTileCounts.Add( tile.Tile() );
 		}
 	}
 
+	uint64_t const heldKinds = m_allTileCounts.KindMask();
+	for ( Suit suit : Suits{} )
+	{
+		uint64_t const suitKinds = heldKinds & ( c_oneSuitMask << ( Suits::ValueToIndex( suit ) * Numbers::Count() ) );
+		m_containsSuitSimples[ suit ] = ( suitKinds & c_simplesMask ) != 0;
+		m_containsSuitTerminals[ suit ] = ( suitKinds & c_terminalsMask ) != 0;
+	}
+	m_containsDragons = ( heldKinds & c_dragonsMask ) != 0;
+	m_containsWinds = ( heldKinds & c_windsMask ) != 0;
 
 	// Finally, make possible hand interpretations
 	// Start by setting up the fixed part determined by the melds
 	HandInterpretation fixedPart;
 	for ( Meld const& meld : i_hand.Melds() )
 	{
+		HandGroup::GroupTiles meldTiles;
+		for ( TileInstance const& tile : meld.Tiles() )
+		{
+			meldTiles.push_back( tile.Tile() );
+		}
 		fixedPart.m_groups.emplace_back(
-			std::ranges::to<Vector<Tile>>( std::views::transform( meld.Tiles(), &TileInstance::GetTile ) ),
+			meldTiles,
 			meld.AssessmentType(),
 			meld.Open()
 		);
 	}
 
-	// Then sort the remaining free tiles
-	Vector<Tile> sortedFreeTiles = std::ranges::to<Vector<Tile>>( std::views::transform( i_hand.FreeTiles(), &TileInstance::GetTile ) );
-	std::ranges::sort( sortedFreeTiles, CompareTileKindOp{} );
-
 	// And visit all the interpreters
 	for ( HandInterpreter const& interpreter : i_rules.Interpreters() )
 	{
-		fixedPart.m_interpreter = interpreter.Name();
-		interpreter.AddInterpretations( m_interpretations, fixedPart, sortedFreeTiles );
+		fixedPart.m_interpreter = interpreter.ID();
+		interpreter.AddInterpretations( m_interpretations, fixedPart, m_freeTileCounts );
 	}
 
-	for ( HandInterpretation const& interpretation : m_interpretations )
+	for ( HandInterpretation& interpretation : m_interpretations )
 	{
-		std::ranges::for_each( interpretation.m_waits, [ this ]( TileKind kind ) { m_overallWaits.insert( kind ); } );
+		m_overallWaits |= interpretation.m_waits;
+		interpretation.m_features.Summarise( interpretation );
 	}
 }
 
@@ -2,8 +2,11 @@
 
 #include "Containers.hpp"
 #include "Declare.hpp"
+#include "HandInterpreter.hpp"
 #include "Seat.hpp"
 #include "Tile.hpp"
+#include "TileCounts.hpp"
+#include "TileKindSet.hpp"
 #include "Utils.hpp"
 
 #include <algorithm>
@@ -43,30 +46,31 @@ public:
 		TileInstance m_tile;
 		Seat m_from;
 	};
+	using TilesFromHand = InplaceVector<TileInstance, 4>; // Inline, so calling and undoing melds doesn't allocate
 
 	template<TileInstanceRange TileInstances = DefaultTileInstanceRange>
 	static Meld MakeSequence( CalledTile i_calledTile, TileInstances&& i_tilesFromHand )
 	{
 		riEnsure( i_tilesFromHand.size() == 2, "2 hand tiles required for sequence" );
-		return { GroupType::Sequence, i_calledTile, std::ranges::to<Vector<TileInstance>>( i_tilesFromHand ) };
+		return { GroupType::Sequence, i_calledTile, TilesFromHand( i_tilesFromHand.begin(), i_tilesFromHand.end() ) };
 	}
 	template<TileInstanceRange TileInstances = DefaultTileInstanceRange>
 	static Meld MakeTriplet( CalledTile i_calledTile, TileInstances&& i_tilesFromHand )
 	{
 		riEnsure( i_tilesFromHand.size() == 2, "2 hand tiles required for triplet" );
-		return { GroupType::Triplet, i_calledTile, std::ranges::to<Vector<TileInstance>>( i_tilesFromHand ) };
+		return { GroupType::Triplet, i_calledTile, TilesFromHand( i_tilesFromHand.begin(), i_tilesFromHand.end() ) };
 	}
 	template<TileInstanceRange TileInstances = DefaultTileInstanceRange>
 	static Meld MakeClosedQuad( TileInstances&& i_tilesFromHand )
 	{
 		riEnsure( i_tilesFromHand.size() == 4, "4 hand tiles required for closed quad" );
-		return { GroupType::Quad, std::nullopt, std::ranges::to<Vector<TileInstance>>( i_tilesFromHand ) };
+		return { GroupType::Quad, std::nullopt, TilesFromHand( i_tilesFromHand.begin(), i_tilesFromHand.end() ) };
 	}
 	template<TileInstanceRange TileInstances = DefaultTileInstanceRange>
 	static Meld MakeOpenQuad( CalledTile i_calledTile, TileInstances&& i_tilesFromHand )
 	{
 		riEnsure( i_tilesFromHand.size() == 3, "3 hand tiles required for open quad" );
-		return { GroupType::Quad, i_calledTile, std::ranges::to<Vector<TileInstance>>( i_tilesFromHand ) };
+		return { GroupType::Quad, i_calledTile, TilesFromHand( i_tilesFromHand.begin(), i_tilesFromHand.end() ) };
 	}
 	Meld& UpgradeTripletToQuad( TileInstance i_tileFromHand )
 	{
@@ -94,12 +98,13 @@ public:
 	TileInstance UpgradedQuadTile() const { riEnsure( UpgradedQuad(), "Cannot get upgraded quad tile if not upgraded quad" ); return m_tilesFromHand.back(); }
 
 private:
-	Meld( GroupType i_type, Option<CalledTile> i_calledTile, Vector<TileInstance> i_tilesFromHand )
+	Meld( GroupType i_type, Option<CalledTile> i_calledTile, TilesFromHand const& i_tilesFromHand )
 		: m_type{i_type}
 		, m_calledTile{ std::move( i_calledTile ) }
-		, m_tilesFromHand{ std::move( i_tilesFromHand ) }
+		, m_tilesFromHand{ i_tilesFromHand }
 	{}
 
+	friend class Hand;
 	friend struct HandAssessment;
 	GroupType AssessmentType() const
 	{
@@ -110,7 +115,7 @@ private:
 
 	GroupType m_type{ GroupType::Sequence };
 	Option<CalledTile> m_calledTile;
-	Vector<TileInstance> m_tilesFromHand;
+	TilesFromHand m_tilesFromHand;
 };
 
 //------------------------------------------------------------------------------
@@ -146,10 +151,16 @@ class Hand
 {
 	Vector<TileInstance> m_freeTiles;
 	Vector<Meld> m_melds;
+	uint64_t m_key{ 0 };
 public:
 
 	Vector<TileInstance> const& FreeTiles() const { return m_freeTiles; }
 	Vector<Meld> const& Melds() const { return m_melds; }
+	TileCounts FreeTileCounts() const { return TileCounts{ m_freeTiles }; }
+
+	// Zobrist-style key of the free tiles and melds, kept up to date as the hand changes.
+	// Hands holding the same tile values (regardless of instance or order) and the same melds share a key.
+	uint64_t Key() const { return m_key; }
 	template<TileInstanceRange TileInstances = DefaultTileInstanceRange>
 	inline void AddFreeTiles( TileInstances&& i_newTiles );
 	void Discard( TileInstance const& i_toDiscard, Option<TileDraw> const& i_drawToAdd );
@@ -157,6 +168,16 @@ public:
 	inline Meld const& CallMeld( TileInstance i_calledTile, Seat i_calledFrom, TileInstances... i_freeHandTiles );
 	inline Meld const& CallMeldFromHand( HandKanOption const& i_kanOption );
 
+	// Taking changes back, for searches that play out moves in place.
+	// Each is given where the change took free tiles from (found beforehand), so the hand ends up exactly as it was, tile order and all.
+	using FreeTileIndices = InplaceVector<uint8_t, 4>;
+	template<TileInstanceRange TileInstances = DefaultTileInstanceRange>
+	inline FreeTileIndices FindFreeTiles( TileInstances&& i_tiles ) const;
+	void RemoveFreeTile( TileInstance const& i_tile ); // Undoes AddFreeTiles for a single tile
+	void UndoDiscard( TileInstance const& i_discarded, size_t i_discardedIndex, Option<TileDraw> const& i_drawAdded );
+	void UndoMeld( FreeTileIndices const& i_from ); // Undoes the last CallMeld, or a closed quad from CallMeldFromHand
+	void UndoUpgradedQuad( TileInstance const& i_upgradeTile, FreeTileIndices const& i_from ); // Undoes an upgraded quad from CallMeldFromHand
+
 	// These questions only consider the hand's tiles against the given TileKind and not the actual validity of the call in the round
 	Vector<ChiOption> ChiOptions( TileKind i_tile ) const;
 	Vector<PonOption> PonOptions( TileKind i_tile ) const;
@@ -170,6 +191,15 @@ public:
 	inline auto AllTiles() const;
 
 	friend std::ostream& operator<<( std::ostream& io_out, Hand const& i_hand );
+
+private:
+	// Equal kinds keep the order they arrived in, so removing a tile again leaves the rest as they were
+	void InsertFreeTile( TileInstance const& i_tile ) { m_freeTiles.insert( std::ranges::upper_bound( m_freeTiles, i_tile, CompareTileKindOp{} ), i_tile ); }
+	void RestoreFreeTiles( Meld::TilesFromHand const& i_tiles, FreeTileIndices const& i_from );
+
+	// Keys are summed rather than xor'd, so that a pair of identical tiles doesn't cancel itself out
+	static uint64_t TileKey( Tile const& i_tile );
+	static uint64_t MeldKey( Meld const& i_meld );
 };
 
 //------------------------------------------------------------------------------
@@ -197,17 +227,20 @@ inline GroupType WaitTypeToGroupType( WaitType i_wait )
 //------------------------------------------------------------------------------
 class HandGroup
 {
-	Vector<Tile> m_tiles; // Sorted, if a sequence
+public:
+	static constexpr size_t c_maxTiles = 4;
+	using GroupTiles = InplaceVector<Tile, c_maxTiles>;
+
+private:
+	GroupTiles m_tiles; // Sorted, if a sequence
 	GroupType m_type{ GroupType::Sequence };
 	bool m_open{ true };
 
 public:
-	HandGroup( Vector<Tile> i_tiles, GroupType i_type, bool i_open );
+	HandGroup( GroupTiles const& i_tiles, GroupType i_type, bool i_open );
 	HandGroup( HandInterpretation const& i_interp, Tile i_winningTile ); // Make a group from the ungrouped + winning tile
-	HandGroup( HandGroup const& ) = default;
-	HandGroup( HandGroup&& ) = default;
 
-	Vector<Tile> const& Tiles() const { return m_tiles; }
+	GroupTiles const& Tiles() const { return m_tiles; }
 	Tile const& operator[]( size_t i ) const { return m_tiles[ i ]; }
 	GroupType Type() const { return m_type; }
 	bool Open() const { return m_open; }
@@ -221,15 +254,44 @@ public:
 	static Tile const& First( HandGroup const& i_group ) { return i_group[ 0 ]; }
 };
 
+//------------------------------------------------------------------------------
+// Facts about an interpretation that many yaku need, summarised once when the hand is assessed.
+// The last tile isn't known until scoring, so yaku still need to account for it themselves.
+//------------------------------------------------------------------------------
+struct HandFeatures
+{
+	// One bit per TileKindIndex, for the lowest tile of each sequence
+	uint64_t m_sequenceStarts{ 0 };
+	uint64_t m_repeatedSequenceStarts{ 0 };
+
+	uint8_t m_sequenceCount{ 0 };
+	uint8_t m_concealedTripletCount{ 0 }; // Including quads
+
+	bool m_allSimples{ true }; // Grouped and ungrouped tiles alike
+	bool m_groupsAllHaveHonourOrTerminal{ true };
+	bool m_groupsAllHaveTerminal{ true };
+	bool m_ungroupedHasHonourOrTerminal{ false };
+	bool m_ungroupedHasTerminal{ false };
+
+	void Summarise( HandInterpretation const& i_interp );
+};
+
+//------------------------------------------------------------------------------
+// Stored inline so that interpretations can be built and copied without touching the heap
 //------------------------------------------------------------------------------
 struct HandInterpretation
 {
-	char const* m_interpreter;
-	Vector<HandGroup> m_groups;
-	Vector<Tile> m_ungrouped;
-	Set<TileKind> m_waits;
+	static constexpr size_t c_maxGroups = 7; // Seven pairs
+	static constexpr size_t c_maxUngrouped = 14;
+
+	InterpreterID m_interpreter;
+	InplaceVector<HandGroup, c_maxGroups> m_groups;
+	InplaceVector<Tile, c_maxUngrouped> m_ungrouped;
+	TileKindSet m_waits;
 	WaitType m_waitType{ WaitType::None };
+	HandFeatures m_features; // Filled in by HandAssessment
 };
+static_assert( std::is_trivially_copyable_v<HandInterpretation> );
 
 //------------------------------------------------------------------------------
 // Useful pre-calculations that saves every yaku checking for the same simple things
@@ -259,13 +321,23 @@ struct HandAssessment
 	bool IsOpen() const { return m_open; }
 
 	explicit HandAssessment( Hand const& i_hand, Rules const& i_rules );
+	// Assesses the hand's melds alongside other free tiles, e.g. to try out discards without copying the hand
+	HandAssessment( Hand const& i_hand, TileCounts const& i_freeTileCounts, Rules const& i_rules );
+
+	// Whether this is an assessment of the given hand as it is, rather than of other free tiles or another hand
+	bool Assesses( Hand const& i_hand ) const { return m_handKey == i_hand.Key(); }
 
 	Vector<HandInterpretation> const& Interpretations() const { return m_interpretations; }
-	Set<TileKind> const& Waits() const { return m_overallWaits; }
+	TileKindSet const& Waits() const { return m_overallWaits; }
+	TileCounts const& FreeTileCounts() const { return m_freeTileCounts; }
+	TileCounts const& AllTileCounts() const { return m_allTileCounts; } // Includes tiles in melds
 
 private:
+	TileCounts m_freeTileCounts;
+	TileCounts m_allTileCounts;
 	Vector<HandInterpretation> m_interpretations;
-	Set<TileKind> m_overallWaits;
+	TileKindSet m_overallWaits;
+	Option<uint64_t> m_handKey; // Only set when assessing a hand's own free tiles
 };
 
 }
@@ -12,8 +12,28 @@ void Hand::AddFreeTiles
 	TileInstances&& i_newTiles
 )
 {
-	m_freeTiles.insert( m_freeTiles.end(), i_newTiles.begin(), i_newTiles.end() );
-	std::ranges::sort( m_freeTiles, CompareTileKindOp{} ); // TODO-QOL: players may not always want their hand sorted
+	for ( TileInstance const& tile : i_newTiles )
+	{
+		m_key += TileKey( tile.Tile() );
+		InsertFreeTile( tile ); // TODO-QOL: players may not always want their hand sorted
+	}
+}
+
+//------------------------------------------------------------------------------
+template<TileInstanceRange TileInstances>
+Hand::FreeTileIndices Hand::FindFreeTiles
+(
+	TileInstances&& i_tiles
+)	const
+{
+	FreeTileIndices indices;
+	for ( TileInstance const& tile : i_tiles )
+	{
+		auto const tileI = std::ranges::find_if( m_freeTiles, EqualsTileInstanceID{ tile } );
+		riEnsure( tileI != m_freeTiles.end(), "Failed to find expected tile in hand" );
+		indices.push_back( static_cast< uint8_t >( tileI - m_freeTiles.begin() ) );
+	}
+	return indices;
 }
 
 //------------------------------------------------------------------------------
@@ -32,6 +52,7 @@ Meld const& Hand::CallMeld
 	// Remove all the free hand tiles
 	[[maybe_unused]] bool const allFreeHandTilesErased = ( Utils::EraseOneIf( m_freeTiles, EqualsTileInstanceID{ i_freeHandTiles } ) && ... );
 	riEnsure( allFreeHandTilesErased, "Failed to find expected tiles in hand to form meld with" );
+	m_key -= ( TileKey( i_freeHandTiles.Tile() ) + ... );
 
 	// Make the new meld
 	if constexpr ( freeHandTileCount == 2 )
@@ -57,6 +78,7 @@ Meld const& Hand::CallMeld
 		m_melds.push_back( Meld::MakeOpenQuad( { i_calledTile, i_calledFrom }, { i_freeHandTiles... } ) );
 	}
 
+	m_key += MeldKey( m_melds.back() );
 	return m_melds.back();
 }
 
@@ -73,6 +95,10 @@ Meld const& Hand::CallMeldFromHand
 		[ this ]( TileInstance const& freeTile ) { return Utils::EraseOneIf( m_freeTiles, EqualsTileInstanceID{ freeTile } ); }
 	);
 	riEnsure( allFreeHandTilesErased, "Failed to find expected tiles in hand to form meld with" );
+	for ( TileInstance const& freeTile : i_kanOption.m_freeHandTilesInvolved )
+	{
+		m_key -= TileKey( freeTile.Tile() );
+	}
 
 	auto kanTiles = i_kanOption.Tiles();
 	EqualsTileKind const sharesTileKind{ i_kanOption.m_callTileKind };
@@ -85,6 +111,7 @@ Meld const& Hand::CallMeldFromHand
 		
 		// Make a new meld
 		m_melds.push_back( Meld::MakeClosedQuad( kanTiles ) );
+		m_key += MeldKey( m_melds.back() );
 	}
 	else
 	{
@@ -96,7 +123,9 @@ Meld const& Hand::CallMeldFromHand
 		{
 			if ( meld.Triplet() && sharesTileKind( meld.SharedTileKind() ) )
 			{
+				m_key -= MeldKey( meld );
 				meld.UpgradeTripletToQuad( kanTiles.front() );
+				m_key += MeldKey( meld );
 				return meld;
 			}
 		}
@@ -0,0 +1,240 @@
+#include "HandEvaluationCache.hpp"
+
+#include "Random.hpp"
+#include "Round.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+
+namespace Riichi
+{
+
+//------------------------------------------------------------------------------
+static double HitRate
+(
+	uint64_t i_hits,
+	uint64_t i_misses
+)
+{
+	uint64_t const lookups = i_hits + i_misses;
+	return lookups == 0 ? 0.0 : static_cast< double >( i_hits ) / static_cast< double >( lookups );
+}
+
+//------------------------------------------------------------------------------
+static uint16_t TileValue
+(
+	Tile const& i_tile
+)
+{
+	return static_cast< uint16_t >( ( size_t{ TileKindIndex{ i_tile } } << 8 ) | i_tile.Bits() );
+}
+
+//------------------------------------------------------------------------------
+double HandEvaluationCache::Stats::AssessmentHitRate
+(
+)	const
+{
+	return HitRate( m_assessmentHits, m_assessmentMisses );
+}
+
+//------------------------------------------------------------------------------
+double HandEvaluationCache::Stats::WaitsHitRate
+(
+)	const
+{
+	return HitRate( m_waitsHits, m_waitsMisses );
+}
+
+//------------------------------------------------------------------------------
+size_t HandEvaluationCache::EntryKey::Hash::operator()
+(
+	EntryKey const& i_key
+)	const
+{
+	uint64_t hash = SplitMix64Finalise( i_key.m_handKey ^ i_key.m_rules.GetValue() );
+	hash = SplitMix64Finalise( hash ^ i_key.m_contextKey );
+	return static_cast< size_t >( hash ^ ( i_key.m_considerForRiichi ? 1u : 0u ) );
+}
+
+//------------------------------------------------------------------------------
+template<typename T_Value>
+HandEvaluationCache::ClockTable<T_Value>::ClockTable
+(
+	size_t i_capacity
+)
+	: m_capacity{ i_capacity }
+{
+	riEnsure( m_capacity > 0, "Cache needs room for at least one entry" );
+	m_slots.reserve( m_capacity );
+	m_index.reserve( m_capacity );
+}
+
+//------------------------------------------------------------------------------
+template<typename T_Value>
+T_Value const* HandEvaluationCache::ClockTable<T_Value>::Find
+(
+	EntryKey const& i_key
+)
+{
+	auto const indexI = m_index.find( i_key );
+	if ( indexI == m_index.end() )
+	{
+		return nullptr;
+	}
+
+	Slot& slot = m_slots[ indexI->second ];
+	slot.m_referenced = true;
+	return &slot.m_value;
+}
+
+//------------------------------------------------------------------------------
+template<typename T_Value>
+T_Value const& HandEvaluationCache::ClockTable<T_Value>::Insert
+(
+	EntryKey const& i_key,
+	T_Value&& i_value,
+	uint64_t& io_evictions
+)
+{
+	riEnsure( !m_index.contains( i_key ), "Key already cached" );
+
+	if ( m_slots.size() < m_capacity )
+	{
+		m_index.emplace( i_key, m_slots.size() );
+		m_slots.push_back( { i_key, false, std::move( i_value ) } );
+		return m_slots.back().m_value;
+	}
+
+	// Give every recently used slot a second chance, taking the first that hasn't been touched since the hand last passed
+	while ( m_slots[ m_hand ].m_referenced )
+	{
+		m_slots[ m_hand ].m_referenced = false;
+		m_hand = ( m_hand + 1 ) % m_capacity;
+	}
+
+	Slot& victim = m_slots[ m_hand ];
+	m_index.erase( victim.m_key );
+	m_index.emplace( i_key, m_hand );
+	victim.m_key = i_key;
+	victim.m_value = std::move( i_value );
+	++io_evictions;
+
+	m_hand = ( m_hand + 1 ) % m_capacity;
+	return victim.m_value;
+}
+
+//------------------------------------------------------------------------------
+template<typename T_Value>
+void HandEvaluationCache::ClockTable<T_Value>::Clear
+(
+)
+{
+	m_slots.clear();
+	m_index.clear();
+	m_hand = 0;
+}
+
+//------------------------------------------------------------------------------
+HandEvaluationCache::HandEvaluationCache
+(
+	size_t i_capacity
+)
+	: m_assessments{ i_capacity }
+	, m_waits{ i_capacity }
+{}
+
+//------------------------------------------------------------------------------
+HandAssessment const& HandEvaluationCache::Assessment
+(
+	Rules const& i_rules,
+	Hand const& i_hand
+)
+{
+	EntryKey const key{ i_hand.Key(), i_rules.ID() };
+	if ( HandAssessment const* cached = m_assessments.Find( key ) )
+	{
+		riEnsure( cached->FreeTileCounts() == i_hand.FreeTileCounts(), "Hand key collision in evaluation cache" );
+		++m_stats.m_assessmentHits;
+		return *cached;
+	}
+
+	++m_stats.m_assessmentMisses;
+	return m_assessments.Insert( key, HandAssessment( i_hand, i_rules ), m_stats.m_evictions );
+}
+
+//------------------------------------------------------------------------------
+Pair<TileKindSet, Vector<TileInstance>> HandEvaluationCache::WaitsWithYaku
+(
+	Rules const& i_rules,
+	Round const& i_round,
+	Seat i_playerSeat,
+	Hand const& i_hand,
+	HandAssessment const& i_assessment,
+	TileDraw const& i_lastTile,
+	bool i_considerForRiichi
+)
+{
+	EntryKey const key{ i_hand.Key(), i_rules.ID(), i_rules.YakuContextKey( i_round, i_playerSeat, i_lastTile ), i_considerForRiichi };
+
+	CachedWaits const* cached = m_waits.Find( key );
+	if ( !cached )
+	{
+		++m_stats.m_waitsMisses;
+		auto [ waits, riichiDiscards ] = i_rules.WaitsWithYaku( i_round, i_playerSeat, i_hand, i_assessment, i_lastTile, i_considerForRiichi );
+
+		// Every copy of a tile value gives the same hand once discarded, so a count per value is all that's needed to rebuild the list
+		CachedWaits toCache{ waits, {} };
+		auto fnCountDiscards = [ & ]( TileInstance const& i_tile )
+		{
+			uint16_t const value = TileValue( i_tile.Tile() );
+			if ( std::ranges::find( toCache.m_riichiDiscardCounts, value, &Pair<uint16_t, uint8_t>::first ) == toCache.m_riichiDiscardCounts.end() )
+			{
+				size_t const count = std::ranges::count( riichiDiscards, i_tile.ID(), &TileInstance::ID );
+				if ( count > 0 )
+				{
+					toCache.m_riichiDiscardCounts.emplace_back( value, static_cast< uint8_t >( count ) );
+				}
+			}
+		};
+		for ( TileInstance const& tile : i_hand.FreeTiles() )
+		{
+			fnCountDiscards( tile );
+		}
+		fnCountDiscards( i_lastTile.m_tile );
+
+		m_waits.Insert( key, std::move( toCache ), m_stats.m_evictions );
+		return { std::move( waits ), std::move( riichiDiscards ) };
+	}
+
+	++m_stats.m_waitsHits;
+
+	// Rebuild the riichi discards in the order the rules would give them: free tiles first, then the drawn tile
+	Vector<TileInstance> riichiDiscards;
+	auto fnAddDiscards = [ & ]( TileInstance const& i_tile )
+	{
+		uint16_t const value = TileValue( i_tile.Tile() );
+		auto const countI = std::ranges::find( cached->m_riichiDiscardCounts, value, &Pair<uint16_t, uint8_t>::first );
+		if ( countI != cached->m_riichiDiscardCounts.end() )
+		{
+			riichiDiscards.insert( riichiDiscards.end(), countI->second, i_tile );
+		}
+	};
+	for ( TileInstance const& tile : i_hand.FreeTiles() )
+	{
+		fnAddDiscards( tile );
+	}
+	fnAddDiscards( i_lastTile.m_tile );
+
+	return { cached->m_waits, std::move( riichiDiscards ) };
+}
+
+//------------------------------------------------------------------------------
+void HandEvaluationCache::Clear
+(
+)
+{
+	m_assessments.Clear();
+	m_waits.Clear();
+}
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Containers.hpp"
+#include "Declare.hpp"
+#include "Hand.hpp"
+#include "IDs.hpp"
+#include "Seat.hpp"
+#include "Tile.hpp"
+#include "TileKindSet.hpp"
+
+namespace Riichi
+{
+
+//------------------------------------------------------------------------------
+// An optional cache in front of hand evaluation, for when the same hands come up
+// again and again, e.g. long simulations or AI searches.
+// Entries are found by Hand::Key() and the rules' ID, along with the rules' yaku context for waits.
+// Memory is bounded by the capacity given, and old entries are evicted with the clock algorithm.
+//------------------------------------------------------------------------------
+class HandEvaluationCache
+{
+public:
+	struct Stats
+	{
+		uint64_t m_assessmentHits{ 0 };
+		uint64_t m_assessmentMisses{ 0 };
+		uint64_t m_waitsHits{ 0 };
+		uint64_t m_waitsMisses{ 0 };
+		uint64_t m_evictions{ 0 };
+
+		double AssessmentHitRate() const;
+		double WaitsHitRate() const;
+	};
+
+	// Capacity is per kind of result, so up to i_capacity assessments and i_capacity waits are kept
+	explicit HandEvaluationCache( size_t i_capacity );
+
+	// Give the same results as building a HandAssessment or asking the rules directly.
+	// The returned assessment is only valid until the cache is next used.
+	HandAssessment const& Assessment( Rules const& i_rules, Hand const& i_hand );
+	Pair<TileKindSet, Vector<TileInstance>> WaitsWithYaku
+	(
+		Rules const& i_rules,
+		Round const& i_round,
+		Seat i_playerSeat,
+		Hand const& i_hand,
+		HandAssessment const& i_assessment,
+		TileDraw const& i_lastTile,
+		bool i_considerForRiichi
+	);
+
+	Stats const& GetStats() const { return m_stats; }
+	size_t Capacity() const { return m_assessments.Capacity(); }
+	void Clear();
+
+private:
+	// Everything an entry was evaluated from, compared in full on lookup rather than trusting a hash of it
+	struct EntryKey
+	{
+		uint64_t m_handKey;
+		RulesID m_rules;
+		uint64_t m_contextKey{ 0 }; // Only for waits
+		bool m_considerForRiichi{ false }; // Only for waits
+
+		bool operator==( EntryKey const& i_other ) const = default;
+
+		struct Hash
+		{
+			size_t operator()( EntryKey const& i_key ) const;
+		};
+	};
+
+	// Fixed number of slots, with a hand sweeping round to find one that hasn't been used recently
+	template<typename T_Value>
+	class ClockTable
+	{
+		struct Slot
+		{
+			EntryKey m_key;
+			bool m_referenced;
+			T_Value m_value;
+		};
+
+		size_t m_capacity;
+		Vector<Slot> m_slots;
+		std::unordered_map<EntryKey, size_t, EntryKey::Hash> m_index;
+		size_t m_hand{ 0 };
+
+	public:
+		explicit ClockTable( size_t i_capacity );
+
+		size_t Capacity() const { return m_capacity; }
+		T_Value const* Find( EntryKey const& i_key );
+		T_Value const& Insert( EntryKey const& i_key, T_Value&& i_value, uint64_t& io_evictions );
+		void Clear();
+	};
+
+	// Riichi discards are stored by tile value rather than instance, so they can be handed back for any hand with the same key
+	struct CachedWaits
+	{
+		TileKindSet m_waits;
+		Vector<Pair<uint16_t, uint8_t>> m_riichiDiscardCounts;
+	};
+
+	ClockTable<HandAssessment> m_assessments;
+	ClockTable<CachedWaits> m_waits;
+	Stats m_stats;
+};
+
+}
@@ -9,11 +9,11 @@ namespace Riichi
 Vector<HandInterpretation> HandInterpreter::GenerateInterpretations
 (
 	HandInterpretation const& i_fixedPart,
-	Vector<Tile> const& i_sortedFreeTiles
+	TileCounts const& i_freeTiles
 )	const
 {
 	Vector<HandInterpretation> interps;
-	AddInterpretations( interps, i_fixedPart, i_sortedFreeTiles );
+	AddInterpretations( interps, i_fixedPart, i_freeTiles );
 	return interps;
 }
 
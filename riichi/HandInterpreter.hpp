@@ -2,29 +2,40 @@
 
 #include "Containers.hpp"
 #include "Declare.hpp"
+#include "IDs.hpp"
 #include "Tile.hpp"
+#include "TileCounts.hpp"
 
 namespace Riichi
 {
 
+//------------------------------------------------------------------------------
+// Given out by the rules on registration, in the order interpreters are added
+using InterpreterID = TypeSafeID<struct InterpreterIDTag, uint8_t>;
+
 //------------------------------------------------------------------------------
 struct HandInterpreter
 {
 	virtual ~HandInterpreter() = default;
 
 	virtual char const* Name() const = 0;
+	InterpreterID ID() const { return m_id; }
 	virtual void AddInterpretations
 	(
 		Vector<HandInterpretation>& io_interps,
 		HandInterpretation const& i_fixedPart,
-		Vector<Tile> const& i_sortedFreeTiles
+		TileCounts const& i_freeTiles
 	) const = 0;
 
 	Vector<HandInterpretation> GenerateInterpretations
 	(
 		HandInterpretation const& i_fixedPart,
-		Vector<Tile> const& i_sortedFreeTiles
+		TileCounts const& i_freeTiles
 	) const;
+
+private:
+	friend struct Rules;
+	InterpreterID m_id;
 };
 
 }
\ No newline at end of file
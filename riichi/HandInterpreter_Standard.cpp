@@ -3,48 +3,72 @@
 #include "Hand.hpp"
 
 #include <algorithm>
+#include <bit>
 
 namespace Riichi
 {
 
 //------------------------------------------------------------------------------
-/*static*/ uint32_t StandardInterpreter::Rank
+static void AddToRank
 (
-	HandInterpretation const& i_interp
+	uint32_t& io_rank,
+	GroupType i_groupType
 )
 {
 	// Bits 0-3 for four triplets
 	// Bits 4-7 for four sequences
 	// Bit 8 for a pair
+	switch ( i_groupType )
+	{
+	case GroupType::Pair:
+	{
+		io_rank |= 1 << 8;
+		break;
+	}
+	case GroupType::Triplet:
+	case GroupType::Quad:
+	{
+		io_rank |= 1 << std::popcount( io_rank & 0x0F );
+		break;
+	}
+	case GroupType::Sequence:
+	{
+		io_rank |= 1 << ( 4 + std::popcount( io_rank & 0xF0 ) );
+		break;
+	}
+	}
+}
+
+//------------------------------------------------------------------------------
+/*static*/ uint32_t StandardInterpreter::Rank
+(
+	HandInterpretation const& i_interp
+)
+{
 	uint32_t rank = 0;
-	int tripleCount = 0;
-	int sequenceCount = 4;
 	for ( HandGroup const& group : i_interp.m_groups )
 	{
-		switch ( group.Type() )
-		{
-		case GroupType::Pair:
-		{
-			rank |= 1 << 8;
-			break;
-		}
-		case GroupType::Triplet:
-		case GroupType::Quad:
-		{
-			rank |= 1 << tripleCount++;
-			break;
-		}
-		case GroupType::Sequence:
-		{
-			rank |= 1 << sequenceCount++;
-			break;
-		}
-		}
+		AddToRank( rank, group.Type() );
 	}
 
 	return rank;
 }
 
+//------------------------------------------------------------------------------
+/*static*/ bool StandardInterpreter::Superseded
+(
+	Vector<HandInterpretation> const& i_interps,
+	uint32_t i_rank
+)
+{
+	return std::ranges::any_of( i_interps, [ i_rank ]( HandInterpretation const& i_existing )
+		{
+			uint32_t const existingRank = Rank( i_existing );
+			return existingRank != i_rank && ( i_rank & existingRank ) == i_rank;
+		}
+	);
+}
+
 //------------------------------------------------------------------------------
 /*static*/ void StandardInterpreter::SetWait
 (
@@ -62,20 +86,20 @@ namespace Riichi
 	if ( io_interpToSet.m_ungrouped.size() == 1 )
 	{
 		io_interpToSet.m_waitType = WaitType::Tanki;
-		io_interpToSet.m_waits.insert( io_interpToSet.m_ungrouped.front() );
+		io_interpToSet.m_waits.Insert( io_interpToSet.m_ungrouped.front() );
 		return;
 	}
 
 	riEnsure( io_interpToSet.m_ungrouped.size() == 2, "Wasn't a tanki wait but didn't have 2 tiles remaining" );
 
-	TileKind const& tile1 = io_interpToSet.m_ungrouped.front();
-	TileKind const& tile2 = io_interpToSet.m_ungrouped.back();
+	TileKindIndex const tile1 = io_interpToSet.m_ungrouped.front();
+	TileKindIndex const tile2 = io_interpToSet.m_ungrouped.back();
 
 	// Check for shanpon second
 	if ( tile1 == tile2 )
 	{
 		io_interpToSet.m_waitType = WaitType::Shanpon;
-		io_interpToSet.m_waits.insert( tile1 );
+		io_interpToSet.m_waits.Insert( tile1 );
 		return;
 	}
 
@@ -86,41 +110,41 @@ namespace Riichi
 		return;
 	}
 
-	if ( tile1.Suit() != tile2.Suit() )
+	if ( tile1.Kind().Suit() != tile2.Kind().Suit() )
 	{
 		// Different suits, no wait
 		return;
 	}
 
 	// Tiles are sorted so this should always be a valid thing to ask - tile2 is either 1 or 2 above tile1
-	if ( tile2.Face() == tile1.Next().Face() )
+	if ( tile2 == tile1.Next() )
 	{
-		if ( tile1.Face() == Face::One )
+		if ( tile1.IsTerminal() )
 		{
 			// Bottom edge
 			io_interpToSet.m_waitType = WaitType::Penchan;
-			io_interpToSet.m_waits.insert( tile2.Next() );
+			io_interpToSet.m_waits.Insert( tile2.Next() );
 			return;
 		}
-		else if ( tile2.Face() == Face::Nine )
+		else if ( tile2.IsTerminal() )
 		{
 			// Top edge
 			io_interpToSet.m_waitType = WaitType::Penchan;
-			io_interpToSet.m_waits.insert( tile1.Prev() );
+			io_interpToSet.m_waits.Insert( tile1.Prev() );
 			return;
 		}
 
 		// Open
 		io_interpToSet.m_waitType = WaitType::Ryanmen;
-		io_interpToSet.m_waits.insert( tile1.Prev() );
-		io_interpToSet.m_waits.insert( tile2.Next() );
+		io_interpToSet.m_waits.Insert( tile1.Prev() );
+		io_interpToSet.m_waits.Insert( tile2.Next() );
 		return;
 	}
-	else if ( tile2.Face() == tile1.Next().Next().Face() )
+	else if ( tile2 == tile1.Next().Next() )
 	{
 		// Middle wait
 		io_interpToSet.m_waitType = WaitType::Kanchan;
-		io_interpToSet.m_waits.insert( tile1.Next() );
+		io_interpToSet.m_waits.Insert( tile1.Next() );
 		return;
 	}
 
@@ -161,119 +185,568 @@ namespace Riichi
 	io_interps.push_back( std::move( io_interpToPush ) );
 }
 
+//------------------------------------------------------------------------------
+struct StandardInterpreter::SearchState
+{
+	static constexpr size_t c_maxTiles = 14;
+	static constexpr size_t c_maxGroups = 5;
+
+	struct Group
+	{
+		GroupType m_type;
+		Array<uint8_t, 3> m_tileIs;
+	};
+
+	HandInterpretation const& m_fixedPart;
+	Array<uint8_t, c_maxTiles> m_sortedKindIs; // Indices as per TileCounts, so adjacent numbers are adjacent indices
+	size_t m_tileCount{ 0 };
+
+	// Tiles that have been taken into a group are marked as used, rather than removed
+	uint32_t m_usedMask{ 0 };
+	size_t m_usedCount{ 0 };
+
+	Array<Group, c_maxGroups> m_groups;
+	size_t m_groupCount{ 0 };
+	bool m_fixedPartHasPair{ false };
+	bool m_hasPair{ false };
+
+	SearchState( HandInterpretation const& i_fixedPart, TileCounts const& i_freeTiles );
+
+	bool Used( size_t i_tileI ) const { return ( m_usedMask & ( 1u << i_tileI ) ) != 0; }
+	size_t NextUnused( size_t i_fromTileI ) const; // Returns m_tileCount if there are none left
+	size_t Remaining() const { return m_tileCount - m_usedCount; }
+	uint32_t Rank() const; // Matches StandardInterpreter::Rank of the interpretation we'd make
+
+	template<size_t t_Size>
+	void PushGroup( GroupType i_type, Array<size_t, t_Size> const& i_tileIs );
+	void PopGroup();
+
+	// Make a full interpretation out of the groups so far and the unused tiles
+	HandInterpretation MakeInterpretation() const;
+};
+
+//------------------------------------------------------------------------------
+StandardInterpreter::SearchState::SearchState
+(
+	HandInterpretation const& i_fixedPart,
+	TileCounts const& i_freeTiles
+)
+	: m_fixedPart( i_fixedPart )
+	, m_fixedPartHasPair( std::ranges::any_of( i_fixedPart.m_groups, []( HandGroup const& group ) { return group.Type() == GroupType::Pair; } ) )
+	, m_hasPair( m_fixedPartHasPair )
+{
+	riEnsure( i_freeTiles.Total() <= c_maxTiles, "Too many free tiles to interpret" );
+	for ( size_t kindI = 0; kindI < TileKindIndex::c_count; ++kindI )
+	{
+		for ( uint8_t copyI = 0; copyI < i_freeTiles[ kindI ]; ++copyI )
+		{
+			m_sortedKindIs[ m_tileCount++ ] = static_cast< uint8_t >( kindI );
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+size_t StandardInterpreter::SearchState::NextUnused
+(
+	size_t i_fromTileI
+)	const
+{
+	while ( i_fromTileI < m_tileCount && Used( i_fromTileI ) )
+	{
+		++i_fromTileI;
+	}
+	return i_fromTileI;
+}
+
+//------------------------------------------------------------------------------
+template<size_t t_Size>
+void StandardInterpreter::SearchState::PushGroup
+(
+	GroupType i_type,
+	Array<size_t, t_Size> const& i_tileIs
+)
+{
+	riEnsure( m_groupCount < c_maxGroups, "Made more groups than can fit in a hand" );
+	Group& group = m_groups[ m_groupCount++ ];
+	group.m_type = i_type;
+	for ( size_t i = 0; i < t_Size; ++i )
+	{
+		group.m_tileIs[ i ] = static_cast< uint8_t >( i_tileIs[ i ] );
+		m_usedMask |= 1u << i_tileIs[ i ];
+	}
+	m_usedCount += t_Size;
+	m_hasPair |= i_type == GroupType::Pair;
+}
+
+//------------------------------------------------------------------------------
+void StandardInterpreter::SearchState::PopGroup
+(
+)
+{
+	Group const& group = m_groups[ --m_groupCount ];
+	size_t const size = group.m_type == GroupType::Pair ? 2 : 3;
+	for ( size_t i = 0; i < size; ++i )
+	{
+		m_usedMask &= ~( 1u << group.m_tileIs[ i ] );
+	}
+	m_usedCount -= size;
+	if ( group.m_type == GroupType::Pair )
+	{
+		// Only one pair is ever made, so we're back to whatever the fixed part had
+		m_hasPair = m_fixedPartHasPair;
+	}
+}
+
+//------------------------------------------------------------------------------
+uint32_t StandardInterpreter::SearchState::Rank
+(
+)	const
+{
+	uint32_t rank = StandardInterpreter::Rank( m_fixedPart );
+	for ( size_t groupI = 0; groupI < m_groupCount; ++groupI )
+	{
+		AddToRank( rank, m_groups[ groupI ].m_type );
+	}
+	return rank;
+}
+
+//------------------------------------------------------------------------------
+HandInterpretation StandardInterpreter::SearchState::MakeInterpretation
+(
+)	const
+{
+	HandInterpretation interp = m_fixedPart;
+	for ( size_t groupI = 0; groupI < m_groupCount; ++groupI )
+	{
+		Group const& group = m_groups[ groupI ];
+		size_t const size = group.m_type == GroupType::Pair ? 2 : 3;
+		HandGroup::GroupTiles tiles;
+		for ( size_t i = 0; i < size; ++i )
+		{
+			tiles.push_back( TileKindIndex{ m_sortedKindIs[ group.m_tileIs[ i ] ] }.Kind() );
+		}
+		interp.m_groups.push_back( HandGroup( tiles, group.m_type, false ) );
+	}
+
+	for ( size_t tileI = NextUnused( 0 ); tileI < m_tileCount; tileI = NextUnused( tileI + 1 ) )
+	{
+		interp.m_ungrouped.push_back( TileKindIndex{ m_sortedKindIs[ tileI ] }.Kind() );
+	}
+	return interp;
+}
+
+//------------------------------------------------------------------------------
+/*static*/ void StandardInterpreter::PushInterp
+(
+	Vector<HandInterpretation>& io_interps,
+	SearchState const& i_state
+)
+{
+	if ( Superseded( io_interps, i_state.Rank() ) )
+	{
+		return;
+	}
+
+	HandInterpretation interp = i_state.MakeInterpretation();
+	PushInterp( io_interps, interp );
+}
+
 //------------------------------------------------------------------------------
 /*static*/ void StandardInterpreter::RecursivelyGenerate
 (
 	Vector<HandInterpretation>& io_interps,
-	HandInterpretation i_soFar,
-	Vector<Tile> i_sortedRemaining,
+	SearchState& io_state,
 	size_t i_nextTileI
 )
 {
 	// Make groups from current tile, when we've run out, work out the wait from the remaining tiles
-	if ( i_sortedRemaining.size() < 3 )
+	if ( io_state.Remaining() < 3 )
 	{
-		i_soFar.m_ungrouped = i_sortedRemaining;
-		PushInterp( io_interps, i_soFar );
+		PushInterp( io_interps, io_state );
 		return;
 	}
 
-	bool const needPair = !std::ranges::any_of( i_soFar.m_groups, []( HandGroup const& group ) { return group.Type() == GroupType::Pair; } );
+	bool const needPair = !io_state.m_hasPair;
 
 	bool madeGroups = false;
-	// TODO-DEBT: This code needs tidying up, and in general the recursive nature could be optimised to avoid copying vectors
-	for ( size_t tileI = i_nextTileI; tileI < i_sortedRemaining.size() - 1; ++tileI )
+	// Tiles before the one we're grouping from are never revisited, so groups are always made in sorted order
+	for ( size_t tileI = io_state.NextUnused( i_nextTileI ); tileI < io_state.m_tileCount; tileI = io_state.NextUnused( tileI + 1 ) )
 	{
-		Tile const& tile = i_sortedRemaining[ tileI ];
-		Tile const& nextTile = i_sortedRemaining[ tileI + 1 ];
+		size_t const nextTileI = io_state.NextUnused( tileI + 1 );
+		if ( nextTileI == io_state.m_tileCount )
+		{
+			break;
+		}
+
+		uint8_t const kindI = io_state.m_sortedKindIs[ tileI ];
+		uint8_t const nextKindI = io_state.m_sortedKindIs[ nextTileI ];
 
 		// Try to make pair
-		if ( needPair && nextTile.Kind() == tile.Kind() )
+		if ( needPair && nextKindI == kindI )
 		{
-			HandInterpretation withPair = i_soFar;
-			withPair.m_groups.push_back( HandGroup( { tile, nextTile }, GroupType::Pair, false ) );
-			Vector<Tile> remTiles = i_sortedRemaining;
-			remTiles.erase( remTiles.begin() + tileI, remTiles.begin() + tileI + 2 );
-			RecursivelyGenerate( io_interps, withPair, remTiles, tileI );
+			io_state.PushGroup( GroupType::Pair, Array<size_t, 2>{ tileI, nextTileI } );
+			RecursivelyGenerate( io_interps, io_state, tileI );
+			io_state.PopGroup();
 			madeGroups = true;
 		}
 
-		if ( tileI >= i_sortedRemaining.size() - 2 )
+		size_t const nextNextTileI = io_state.NextUnused( nextTileI + 1 );
+		if ( nextNextTileI == io_state.m_tileCount )
 		{
 			// Ran out of tiles to check
 			break;
 		}
 
 		// Try to make triplet
-		Tile const& nextNextTile = i_sortedRemaining[ tileI + 2 ];
-		if ( nextTile.Kind() == tile.Kind() && nextNextTile.Kind() == tile.Kind() )
+		uint8_t const nextNextKindI = io_state.m_sortedKindIs[ nextNextTileI ];
+		if ( nextKindI == kindI && nextNextKindI == kindI )
 		{
-			HandInterpretation withTriplet = i_soFar;
-			withTriplet.m_groups.push_back( HandGroup( { tile, nextTile, nextNextTile }, GroupType::Triplet, false ) );
-			Vector<Tile> remTiles = i_sortedRemaining;
-			remTiles.erase( remTiles.begin() + tileI, remTiles.begin() + tileI + 3 );
-			RecursivelyGenerate( io_interps, withTriplet, remTiles, tileI );
+			io_state.PushGroup( GroupType::Triplet, Array<size_t, 3>{ tileI, nextTileI, nextNextTileI } );
+			RecursivelyGenerate( io_interps, io_state, tileI );
+			io_state.PopGroup();
 			madeGroups = true;
 		}
 
 		// Try to make sequence
-		if ( tile.IsNumber() )
+		TileKindIndex const tile{ kindI };
+		if ( !tile.IsNumber() || tile.Kind().Face() >= Face::Eight )
+		{
+			// Can't find two tiles of higher value as this one is already too high
+			continue;
+		}
+
+		// Tiles are sorted, so the first unused tile of each of the next two kinds is all that needs finding
+		auto fnFindNext = [ &io_state ]( size_t i_afterTileI, size_t i_kindI )
+		{
+			for ( size_t findI = io_state.NextUnused( i_afterTileI + 1 ); findI < io_state.m_tileCount; findI = io_state.NextUnused( findI + 1 ) )
+			{
+				if ( io_state.m_sortedKindIs[ findI ] >= i_kindI )
+				{
+					return io_state.m_sortedKindIs[ findI ] == i_kindI ? findI : io_state.m_tileCount;
+				}
+			}
+			return io_state.m_tileCount;
+		};
+
+		size_t const tile2I = fnFindNext( tileI, kindI + 1u );
+		if ( tile2I == io_state.m_tileCount )
+		{
+			continue;
+		}
+		size_t const tile3I = fnFindNext( tile2I, kindI + 2u );
+		if ( tile3I == io_state.m_tileCount )
+		{
+			continue;
+		}
+
+		io_state.PushGroup( GroupType::Sequence, Array<size_t, 3>{ tileI, tile2I, tile3I } );
+		RecursivelyGenerate( io_interps, io_state, tileI );
+		io_state.PopGroup();
+		madeGroups = true;
+	}
+
+	// Failed to make any more groups with this hand so it's an interp on its own
+	if ( !madeGroups )
+	{
+		PushInterp( io_interps, io_state );
+	}
+}
+
+//------------------------------------------------------------------------------
+// Decomposition tables
+// Every suit (and the honours) can be decomposed into groups independently of the others.
+// Within a suit we only keep the decompositions that aren't beaten on triplets and sequences
+// by another with the same number of pairs, since any interpretation built using a beaten one
+// would be superseded in PushInterp anyway. What's left is small, and cached per count pattern.
+//------------------------------------------------------------------------------
+struct SuitGroup
+{
+	GroupType m_type;
+	uint8_t m_firstKindI; // Relative to the first kind of the suit
+};
+
+//------------------------------------------------------------------------------
+struct SuitDecomposition
+{
+	static constexpr size_t c_maxGroups = 5; // 4 groups and a pair is more than the tiles in a hand allow
+
+	Array<SuitGroup, c_maxGroups> m_groups{};
+	uint8_t m_groupCount{ 0 };
+	uint8_t m_triplets{ 0 };
+	uint8_t m_sequences{ 0 };
+};
+
+//------------------------------------------------------------------------------
+struct SuitDecompositions
+{
+	Array<Vector<SuitDecomposition>, 2> m_byPairCount;
+};
+
+//------------------------------------------------------------------------------
+static void AddSuitDecomposition
+(
+	Vector<SuitDecomposition>& io_decompositions,
+	SuitDecomposition const& i_decomposition
+)
+{
+	for ( auto decompI = io_decompositions.begin(); decompI != io_decompositions.end(); /*++decompI*/ )
+	{
+		bool const sameScore = decompI->m_triplets == i_decomposition.m_triplets && decompI->m_sequences == i_decomposition.m_sequences;
+		if ( !sameScore )
+		{
+			if ( decompI->m_triplets >= i_decomposition.m_triplets && decompI->m_sequences >= i_decomposition.m_sequences )
+			{
+				return;
+			}
+			else if ( decompI->m_triplets <= i_decomposition.m_triplets && decompI->m_sequences <= i_decomposition.m_sequences )
+			{
+				decompI = io_decompositions.erase( decompI );
+				continue;
+			}
+		}
+		++decompI;
+	}
+
+	io_decompositions.push_back( i_decomposition );
+}
+
+//------------------------------------------------------------------------------
+static void DecomposeSuit
+(
+	SuitDecompositions& io_decompositions,
+	SuitDecomposition& io_soFar,
+	Span<uint8_t> io_remaining,
+	bool i_allowSequences,
+	bool i_pairUsed,
+	size_t i_kindI
+)
+{
+	if ( i_kindI == io_remaining.size() )
+	{
+		AddSuitDecomposition( io_decompositions.m_byPairCount[ i_pairUsed ? 1 : 0 ], io_soFar );
+		return;
+	}
+
+	uint8_t const count = io_remaining[ i_kindI ];
+	bool const canStartSequence = i_allowSequences && i_kindI + 2 < io_remaining.size();
+	uint8_t const maxSequences = canStartSequence ? std::min( { count, io_remaining[ i_kindI + 1 ], io_remaining[ i_kindI + 2 ] } ) : 0;
+
+	// Groups are added pair first, then triplet, then sequences, which is the order the recursive search tries them in
+	for ( uint8_t pair = 0; pair < ( i_pairUsed ? 1 : 2 ); ++pair )
+	{
+		for ( uint8_t triplet = 0; triplet < 2; ++triplet )
 		{
-			if ( tile.Face() >= Face::Eight )
+			if ( 2 * pair + 3 * triplet > count )
 			{
-				// Can't find two tiles of higher value as this one is already too high
 				continue;
 			}
-			bool gotSequence = false;
-			for ( size_t tile2I = tileI + 1; tile2I < i_sortedRemaining.size(); ++tile2I )
+
+			uint8_t const groupCount = io_soFar.m_groupCount;
+			if ( pair > 0 )
+			{
+				io_soFar.m_groups[ io_soFar.m_groupCount++ ] = { GroupType::Pair, static_cast< uint8_t >( i_kindI ) };
+			}
+			if ( triplet > 0 )
+			{
+				io_soFar.m_groups[ io_soFar.m_groupCount++ ] = { GroupType::Triplet, static_cast< uint8_t >( i_kindI ) };
+				++io_soFar.m_triplets;
+			}
+
+			uint8_t const spareForSequences = static_cast< uint8_t >( count - 2 * pair - 3 * triplet );
+			for ( uint8_t sequences = 0; sequences <= std::min( maxSequences, spareForSequences ); ++sequences )
 			{
-				Tile const& tile2 = i_sortedRemaining[ tile2I ];
-				if ( tile2.IsNumber() )
+				if ( io_soFar.m_groupCount + sequences > SuitDecomposition::c_maxGroups )
+				{
+					break;
+				}
+
+				for ( uint8_t seqI = 0; seqI < sequences; ++seqI )
 				{
-					if ( tile.Suit() == tile2.Suit() && tile2.Face() == tile.Next().Face() )
-					{
-						// Found second tile, try for third
-						for ( size_t tile3I = tile2I + 1; tile3I < i_sortedRemaining.size(); ++tile3I )
-						{
-							Tile const& tile3 = i_sortedRemaining[ tile3I ];
-							if ( tile3.IsNumber() )
-							{
-								if ( tile.Suit() == tile3.Suit() && tile3.Face() == tile2.Next().Face() )
-								{
-									// Found three tiles
-									HandInterpretation withSeq = i_soFar;
-									withSeq.m_groups.push_back( HandGroup( { tile, tile2, tile3 }, GroupType::Sequence, false ) );
-									Vector<Tile> remTiles = i_sortedRemaining;
-									remTiles.erase( remTiles.begin() + tile3I );
-									remTiles.erase( remTiles.begin() + tile2I );
-									remTiles.erase( remTiles.begin() + tileI );
-									RecursivelyGenerate( io_interps, withSeq, remTiles, tileI );
-									madeGroups = true;
-									gotSequence = true;
-
-									// TODO-DEBT: Look at this nesting:
-								}
-							}
-							if ( gotSequence )
-							{
-								break;
-							}
-						}
-					}
+					io_soFar.m_groups[ io_soFar.m_groupCount + seqI ] = { GroupType::Sequence, static_cast< uint8_t >( i_kindI ) };
 				}
-				if ( gotSequence )
+				io_soFar.m_groupCount += sequences;
+				io_soFar.m_sequences += sequences;
+				if ( sequences > 0 )
+				{
+					io_remaining[ i_kindI + 1 ] -= sequences;
+					io_remaining[ i_kindI + 2 ] -= sequences;
+				}
+
+				DecomposeSuit( io_decompositions, io_soFar, io_remaining, i_allowSequences, i_pairUsed || pair > 0, i_kindI + 1 );
+
+				if ( sequences > 0 )
+				{
+					io_remaining[ i_kindI + 1 ] += sequences;
+					io_remaining[ i_kindI + 2 ] += sequences;
+				}
+				io_soFar.m_groupCount -= sequences;
+				io_soFar.m_sequences -= sequences;
+			}
+
+			io_soFar.m_triplets -= triplet;
+			io_soFar.m_groupCount = groupCount;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+static SuitDecompositions const& LookupSuitDecompositions
+(
+	TileCounts const& i_counts,
+	size_t i_firstKindI,
+	size_t i_kindCount,
+	bool i_allowSequences
+)
+{
+	// Only the one thread ever touches its own cache, so there's no need for locking
+	thread_local Map<uint32_t, SuitDecompositions> s_cache;
+
+	uint32_t pattern = i_allowSequences ? 1 : 0;
+	Array<uint8_t, Numbers::Count()> counts{};
+	for ( size_t kindI = 0; kindI < i_kindCount; ++kindI )
+	{
+		counts[ kindI ] = i_counts[ i_firstKindI + kindI ];
+		pattern = pattern * 5 + counts[ kindI ];
+	}
+
+	auto [ entryI, inserted ] = s_cache.try_emplace( pattern );
+	if ( inserted )
+	{
+		SuitDecomposition soFar;
+		DecomposeSuit( entryI->second, soFar, Span<uint8_t>( counts.data(), i_kindCount ), i_allowSequences, false, 0 );
+	}
+	return entryI->second;
+}
+
+//------------------------------------------------------------------------------
+/*static*/ void StandardInterpreter::GenerateFromTables
+(
+	Vector<HandInterpretation>& io_interps,
+	HandInterpretation const& i_fixedPart,
+	TileCounts const& i_freeTiles
+)
+{
+	size_t constexpr c_categoryCount = Suits::Count() + 1;
+	size_t constexpr c_honoursFirstKindI = Suits::Count() * Numbers::Count();
+	Array<SuitDecompositions const*, c_categoryCount> const categories{
+		&LookupSuitDecompositions( i_freeTiles, 0, Numbers::Count(), true ),
+		&LookupSuitDecompositions( i_freeTiles, Numbers::Count(), Numbers::Count(), true ),
+		&LookupSuitDecompositions( i_freeTiles, 2 * Numbers::Count(), Numbers::Count(), true ),
+		&LookupSuitDecompositions( i_freeTiles, c_honoursFirstKindI, Honours::Count(), false ),
+	};
+
+	// Gather every combination, across each choice of where the pair comes from (including nowhere)
+	// Only the free tile groups are ranked here, as the fixed part is the same for all of them
+	struct Candidate
+	{
+		Array<SuitDecomposition const*, c_categoryCount> m_parts;
+		uint8_t m_triplets;
+		uint8_t m_sequences;
+		bool m_pair;
+	};
+	Vector<Candidate> candidates;
+
+	for ( size_t pairCategoryI = 0; pairCategoryI <= c_categoryCount; ++pairCategoryI )
+	{
+		Array<Vector<SuitDecomposition> const*, c_categoryCount> options;
+		bool anyEmpty = false;
+		for ( size_t categoryI = 0; categoryI < c_categoryCount; ++categoryI )
+		{
+			options[ categoryI ] = &categories[ categoryI ]->m_byPairCount[ categoryI == pairCategoryI ? 1 : 0 ];
+			anyEmpty |= options[ categoryI ]->empty();
+		}
+		if ( anyEmpty )
+		{
+			continue;
+		}
+
+		Array<size_t, c_categoryCount> choiceIs{};
+		while ( true )
+		{
+			Candidate candidate{ {}, 0, 0, pairCategoryI < c_categoryCount };
+			for ( size_t categoryI = 0; categoryI < c_categoryCount; ++categoryI )
+			{
+				SuitDecomposition const& part = ( *options[ categoryI ] )[ choiceIs[ categoryI ] ];
+				candidate.m_parts[ categoryI ] = &part;
+				candidate.m_triplets += part.m_triplets;
+				candidate.m_sequences += part.m_sequences;
+			}
+			candidates.push_back( candidate );
+
+			size_t categoryI = 0;
+			for ( ; categoryI < c_categoryCount; ++categoryI )
+			{
+				if ( ++choiceIs[ categoryI ] < options[ categoryI ]->size() )
 				{
 					break;
 				}
+				choiceIs[ categoryI ] = 0;
+			}
+			if ( categoryI == c_categoryCount )
+			{
+				break;
 			}
 		}
 	}
 
-	// Failed to make any more groups with this hand so it's an interp on its own
-	if ( !madeGroups )
+	auto fnSupersedes = []( Candidate const& i_a, Candidate const& i_b )
+	{
+		return i_a.m_triplets >= i_b.m_triplets && i_a.m_sequences >= i_b.m_sequences && i_a.m_pair >= i_b.m_pair
+			&& ( i_a.m_triplets != i_b.m_triplets || i_a.m_sequences != i_b.m_sequences || i_a.m_pair != i_b.m_pair );
+	};
+
+	size_t constexpr c_firstKindIs[ c_categoryCount ] = { 0, Numbers::Count(), 2 * Numbers::Count(), c_honoursFirstKindI };
+	for ( Candidate const& candidate : candidates )
 	{
-		i_soFar.m_ungrouped = i_sortedRemaining;
-		PushInterp( io_interps, i_soFar );
+		if ( std::ranges::any_of( candidates, [ & ]( Candidate const& i_other ) { return fnSupersedes( i_other, candidate ); } ) )
+		{
+			continue;
+		}
+
+		HandInterpretation interp = i_fixedPart;
+		TileCounts remaining = i_freeTiles;
+		for ( size_t categoryI = 0; categoryI < c_categoryCount; ++categoryI )
+		{
+			SuitDecomposition const& part = *candidate.m_parts[ categoryI ];
+			for ( size_t groupI = 0; groupI < part.m_groupCount; ++groupI )
+			{
+				SuitGroup const& group = part.m_groups[ groupI ];
+				size_t const kindI = c_firstKindIs[ categoryI ] + group.m_firstKindI;
+				HandGroup::GroupTiles tiles;
+				switch ( group.m_type )
+				{
+				case GroupType::Pair:
+				{
+					tiles.assign( 2, Tile{ TileKindIndex{ kindI }.Kind() } );
+					break;
+				}
+				case GroupType::Triplet:
+				{
+					tiles.assign( 3, Tile{ TileKindIndex{ kindI }.Kind() } );
+					break;
+				}
+				case GroupType::Sequence:
+				{
+					tiles = { TileKindIndex{ kindI }.Kind(), TileKindIndex{ kindI + 1 }.Kind(), TileKindIndex{ kindI + 2 }.Kind() };
+					break;
+				}
+				case GroupType::Quad:
+				{
+					riError( "Decomposition tables never produce quads" );
+					break;
+				}
+				}
+
+				for ( Tile const& tile : tiles )
+				{
+					remaining.Remove( tile.Kind() );
+				}
+				interp.m_groups.push_back( HandGroup( tiles, group.m_type, false ) );
+			}
+		}
+
+		remaining.AppendSortedTiles( interp.m_ungrouped );
+		PushInterp( io_interps, interp );
 	}
 }
 
@@ -282,7 +755,7 @@ void StandardInterpreter::AddInterpretations
 (
 	Vector<HandInterpretation>& io_interps,
 	HandInterpretation const& i_fixedPart,
-	Vector<Tile> const& i_sortedFreeTiles
+	TileCounts const& i_freeTiles
 )	const
 {
 	// Standard hand interpretations. This is for the typical "4 groups + 1 pair" type of hand.
@@ -297,7 +770,17 @@ void StandardInterpreter::AddInterpretations
 	//             and means we don't bother considering 'weaker' interpretations later.
 	//             But it comes with the caveat that there *may* be a novel interpretation worth considering that happened to be ranked weaker. TODO-DEBT: test whether these actually exist
 
-	RecursivelyGenerate( io_interps, i_fixedPart, i_sortedFreeTiles, 0 );
+	// The tables only reproduce the recursive results when there's one tile left over after every group is made, as in a normal 13 tile hand.
+	// Otherwise the recursion can stop short of a full hand (e.g. it'll treat a complete 14 tile hand as a shanpon wait), so we keep to that
+	size_t constexpr c_maxTableTiles = 13;
+	if ( m_mode == Mode::DecompositionTables && i_freeTiles.Total() % 3 == 1 && i_freeTiles.Total() <= c_maxTableTiles )
+	{
+		GenerateFromTables( io_interps, i_fixedPart, i_freeTiles );
+		return;
+	}
+
+	SearchState state( i_fixedPart, i_freeTiles );
+	RecursivelyGenerate( io_interps, state, 0 );
 }
 
 //------------------------------------------------------------------------------
@@ -305,7 +788,7 @@ void SevenPairsInterpreter::AddInterpretations
 (
 	Vector<HandInterpretation>& io_interps,
 	HandInterpretation const& i_fixedPart,
-	Vector<Tile> const& i_sortedFreeTiles
+	TileCounts const& i_freeTiles
 )	const
 {
 	// Unlike standard interpretations, there's only one way this can go.
@@ -318,35 +801,26 @@ void SevenPairsInterpreter::AddInterpretations
 	}
 
 	// Fill as many pairs as we can make - there's only ever 1 interpretation with chiitoitsu
+	// Each kind can contribute at most one pair, anything beyond that is left ungrouped
 	HandInterpretation interp = i_fixedPart;
-
-	for ( size_t tileI = 0; tileI < i_sortedFreeTiles.size(); ++tileI )
-	{
-		Tile const& tile1 = i_sortedFreeTiles[ tileI ];
-
-		if ( tileI == i_sortedFreeTiles.size() - 1 )
+	i_freeTiles.ForEachKind(
+		[ &interp ]( TileKind i_kind, uint8_t i_count )
 		{
-			interp.m_ungrouped.push_back( tile1 );
-			break;
+			if ( i_count >= 2 )
+			{
+				interp.m_groups.push_back( HandGroup{ { Tile{ i_kind }, Tile{ i_kind } }, GroupType::Pair, false } );
+				i_count -= 2;
+			}
+			for ( uint8_t i = 0; i < i_count; ++i )
+			{
+				interp.m_ungrouped.push_back( Tile{ i_kind } );
+			}
 		}
+	);
 
-		Tile const& tile2 = i_sortedFreeTiles[ tileI + 1 ];
-
-		// Matching and unique
-		if ( tile1.Kind() == tile2.Kind() && !std::ranges::any_of( interp.m_groups, EqualsTileKind{ tile1 }, &HandGroup::First ) )
-		{
-			interp.m_groups.push_back( HandGroup{ {tile1, tile2}, GroupType::Pair, false } );
-			tileI++;
-		}
-		else
-		{
-			interp.m_ungrouped.push_back( tile1 );
-		}
-	}
-	
 	if ( interp.m_ungrouped.size() == 1 && !std::ranges::any_of( interp.m_groups, EqualsTileKind{ interp.m_ungrouped[ 0 ] }, &HandGroup::First ) )
 	{
-		interp.m_waits.insert( interp.m_ungrouped[ 0 ] );
+		interp.m_waits.Insert( interp.m_ungrouped[ 0 ] );
 		interp.m_waitType = WaitType::Tanki;
 	}
 
@@ -359,7 +833,7 @@ void ThirteenOrphansInterpreter::AddInterpretations
 (
 	Vector<HandInterpretation>& io_interps,
 	HandInterpretation const& i_fixedPart,
-	Vector<Tile> const& i_sortedFreeTiles
+	TileCounts const& i_freeTiles
 )	const
 {
 	// Unlike standard interpretations, there's only one way this can go.
@@ -374,38 +848,36 @@ void ThirteenOrphansInterpreter::AddInterpretations
 	// We're going to add all free tiles to the ungrouped list
 	// But then assess the waits based on if we actually have kokushi musou
 	HandInterpretation interp = i_fixedPart;
-	interp.m_ungrouped = i_sortedFreeTiles;
-
-	// TODO-OPT: Can we do this without filling a container?
-
-	Vector<TileKind> requiredTiles{
-		{ Suit::Manzu, Face::One },
-		{ Suit::Manzu, Face::Nine },
-		{ Suit::Pinzu, Face::One },
-		{ Suit::Pinzu, Face::Nine },
-		{ Suit::Souzu, Face::One },
-		{ Suit::Souzu, Face::Nine },
-		Face::Haku,
-		Face::Hatsu,
-		Face::Chun,
-		Face::East,
-		Face::South,
-		Face::West,
-		Face::North,
-	};
+	i_freeTiles.AppendSortedTiles( interp.m_ungrouped );
 
-	for ( Tile const& tile : interp.m_ungrouped )
+	size_t orphanKinds = 0;
+	Option<TileKind> missingKind;
+	for ( size_t kindI = 0; kindI < TileKindIndex::c_count; ++kindI )
 	{
-		if ( !tile.IsHonourOrTerminal() )
+		TileKindIndex const kind{ kindI };
+		if ( !kind.IsHonourOrTerminal() )
 		{
-			// We have an invalid tile for 13 orphans, so definitely no waits here
-			io_interps.push_back( std::move( interp ) );
-			return;
+			if ( i_freeTiles[ kindI ] > 0 )
+			{
+				// We have an invalid tile for 13 orphans, so definitely no waits here
+				io_interps.push_back( std::move( interp ) );
+				return;
+			}
+			continue;
+		}
+
+		if ( i_freeTiles[ kindI ] > 0 )
+		{
+			++orphanKinds;
+		}
+		else
+		{
+			missingKind = kind.Kind();
 		}
-		std::erase( requiredTiles, tile.Kind() );
 	}
-	
-	if ( requiredTiles.size() > 1 )
+
+	size_t constexpr c_orphanKindCount = 13;
+	if ( orphanKinds + 1 < c_orphanKindCount )
 	{
 		// Don't have enough unique tiles to have a wait for 13 orphans
 		io_interps.push_back( std::move( interp ) );
@@ -415,16 +887,16 @@ void ThirteenOrphansInterpreter::AddInterpretations
 	// Must have a wait if we reached this far
 	interp.m_waitType = WaitType::Tanki;
 
-	if ( requiredTiles.size() == 1 )
+	if ( missingKind.has_value() )
 	{
 		// Have a pair inside the hand already, so there's exactly 1 tile left
-		interp.m_waits.insert( requiredTiles[ 0 ] );
+		interp.m_waits.Insert( *missingKind );
 	}
 	else
 	{
-		riEnsure( requiredTiles.size() == 0, "Did not have a valid number of unique tiles when assessing 13 orphans" );
-		// We have 1 of every tile, so this is a 13 tile wait. Luckily we have a full set of 13 tiles in our ungrouped list! :)
-		std::ranges::for_each( interp.m_ungrouped, [ & ]( TileKind kind ) { interp.m_waits.insert( kind ); } );
+		riEnsure( orphanKinds == c_orphanKindCount, "Did not have a valid number of unique tiles when assessing 13 orphans" );
+		// We have 1 of every tile, so this is a 13 tile wait
+		i_freeTiles.ForEachKind( [ &interp ]( TileKind i_kind, uint8_t ) { interp.m_waits.Insert( i_kind ); } );
 	}
 
 	io_interps.push_back( std::move( interp ) );
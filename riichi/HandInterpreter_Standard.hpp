@@ -9,19 +9,34 @@ namespace Riichi
 class StandardInterpreter final
 	: public HandInterpreter
 {
+public:
+	enum class Mode : EnumValueType
+	{
+		Recursive,				// Search for groups tile-by-tile
+		DecompositionTables,	// Combine cached per-suit decompositions. Only differs from Recursive in
+								// that it produces each interpretation once, where the recursive search can
+								// produce repeats with groups that share a first tile in a different order
+	};
+
+	explicit StandardInterpreter( Mode i_mode = Mode::Recursive ) : m_mode( i_mode ) {}
+
+private:
+	Mode m_mode;
+
 	char const* Name() const { return "Standard"; }
 
 	void AddInterpretations
 	(
 		Vector<HandInterpretation>& io_interps,
 		HandInterpretation const& i_fixedPart,
-		Vector<Tile> const& i_sortedFreeTiles
+		TileCounts const& i_freeTiles
 	) const;
 
 private:
 	// A special bitmask that allows us to determine if an interpretation is superseded by another
 	// i.e. holds the same kinds of groupings but fewer of them
 	static uint32_t Rank( HandInterpretation const& i_interp );
+	static bool Superseded( Vector<HandInterpretation> const& i_interps, uint32_t i_rank );
 
 	static void SetWait( HandInterpretation& io_interpToSet );
 
@@ -31,13 +46,29 @@ private:
 		HandInterpretation& io_interpToPush
 	);
 
+	// Fixed-size working space for the recursive search, so that it never needs to allocate
+	struct SearchState;
+
+	// Only makes the interpretation if it won't be immediately superseded
+	static void PushInterp
+	(
+		Vector<HandInterpretation>& io_interps,
+		SearchState const& i_state
+	);
+
 	static void RecursivelyGenerate
 	(
 		Vector<HandInterpretation>& io_interps,
-		HandInterpretation i_soFar,
-		Vector<Tile> i_sortedRemaining,
+		SearchState& io_state,
 		size_t i_nextTileI
 	);
+
+	static void GenerateFromTables
+	(
+		Vector<HandInterpretation>& io_interps,
+		HandInterpretation const& i_fixedPart,
+		TileCounts const& i_freeTiles
+	);
 };
 
 //------------------------------------------------------------------------------
@@ -50,7 +81,7 @@ class SevenPairsInterpreter final
 	(
 		Vector<HandInterpretation>& io_interps,
 		HandInterpretation const& i_fixedPart,
-		Vector<Tile> const& i_sortedFreeTiles
+		TileCounts const& i_freeTiles
 	) const;
 };
 
@@ -64,7 +95,7 @@ class ThirteenOrphansInterpreter final
 	(
 		Vector<HandInterpretation>& io_interps,
 		HandInterpretation const& i_fixedPart,
-		Vector<Tile> const& i_sortedFreeTiles
+		TileCounts const& i_freeTiles
 	) const;
 };
 
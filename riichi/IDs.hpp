@@ -83,6 +83,7 @@ public:
 // Important ID Types
 //------------------------------------------------------------------------------
 using TableIdent = TypeSafeID<struct TableIdentTag>;
+using RulesID = TypeSafeID<struct RulesIDTag, uint64_t>;
 
 }
 
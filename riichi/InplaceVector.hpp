@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Base.hpp"
+#include "DebugUtils.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace Riichi::Utils
+{
+
+//------------------------------------------------------------------------------
+// A vector with a fixed capacity, storing its elements inline rather than on the heap.
+// Only holds trivial types, so that the whole container stays trivially copyable
+// and can be passed around and stored like any other small value.
+//------------------------------------------------------------------------------
+template<typename T, size_t t_Capacity>
+	requires std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>
+class InplaceVector
+{
+	static_assert( t_Capacity > 0 && t_Capacity <= UINT8_MAX, "InplaceVector only supports small capacities" );
+
+	// Elements don't need to be default constructible, so leave the storage uninitialised until used
+	union Storage
+	{
+		constexpr Storage() : m_unused{} {}
+
+		char m_unused;
+		T m_items[ t_Capacity ];
+	};
+
+	Storage m_storage;
+	uint8_t m_size{ 0 };
+
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using reference = T&;
+	using const_reference = T const&;
+	using pointer = T*;
+	using const_pointer = T const*;
+	using iterator = T*;
+	using const_iterator = T const*;
+
+	constexpr InplaceVector() = default;
+	constexpr InplaceVector( std::initializer_list<T> i_items ) { assign( i_items.begin(), i_items.end() ); }
+	constexpr InplaceVector( size_t i_count, T const& i_value ) { assign( i_count, i_value ); }
+	template<std::input_iterator T_Iter, std::sentinel_for<T_Iter> T_Sentinel>
+	constexpr InplaceVector( T_Iter i_begin, T_Sentinel i_end ) { assign( i_begin, i_end ); }
+
+	static constexpr size_t capacity() { return t_Capacity; }
+	constexpr size_t size() const { return m_size; }
+	constexpr bool empty() const { return m_size == 0; }
+	constexpr bool full() const { return m_size == t_Capacity; }
+
+	constexpr T* data() { return m_storage.m_items; }
+	constexpr T const* data() const { return m_storage.m_items; }
+
+	constexpr iterator begin() { return data(); }
+	constexpr const_iterator begin() const { return data(); }
+	constexpr iterator end() { return data() + m_size; }
+	constexpr const_iterator end() const { return data() + m_size; }
+
+	constexpr T& operator[]( size_t i_index ) { riEnsure( i_index < m_size, "InplaceVector index out of range" ); return data()[ i_index ]; }
+	constexpr T const& operator[]( size_t i_index ) const { riEnsure( i_index < m_size, "InplaceVector index out of range" ); return data()[ i_index ]; }
+	constexpr T& front() { return ( *this )[ 0 ]; }
+	constexpr T const& front() const { return ( *this )[ 0 ]; }
+	constexpr T& back() { return ( *this )[ m_size - 1u ]; }
+	constexpr T const& back() const { return ( *this )[ m_size - 1u ]; }
+
+	template<typename... T_Args>
+	constexpr T& emplace_back( T_Args&&... i_args )
+	{
+		riEnsure( !full(), "InplaceVector is already at capacity" );
+		return *std::construct_at( data() + m_size++, std::forward<T_Args>( i_args )... );
+	}
+	constexpr void push_back( T const& i_item ) { emplace_back( i_item ); }
+	constexpr void pop_back() { riEnsure( !empty(), "Cannot pop from an empty InplaceVector" ); --m_size; }
+	constexpr void clear() { m_size = 0; }
+
+	constexpr void assign( size_t i_count, T const& i_value )
+	{
+		clear();
+		for ( size_t i = 0; i < i_count; ++i )
+		{
+			push_back( i_value );
+		}
+	}
+	template<std::input_iterator T_Iter, std::sentinel_for<T_Iter> T_Sentinel>
+	constexpr void assign( T_Iter i_begin, T_Sentinel i_end )
+	{
+		clear();
+		for ( ; i_begin != i_end; ++i_begin )
+		{
+			push_back( *i_begin );
+		}
+	}
+
+	friend constexpr bool operator==( InplaceVector const& i_a, InplaceVector const& i_b )
+	{
+		return std::ranges::equal( i_a, i_b );
+	}
+};
+
+}
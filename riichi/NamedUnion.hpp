@@ -5,6 +5,7 @@
 #include <concepts>
 #include <compare>
 #include <type_traits>
+#include <utility>
 
 namespace Riichi
 {
@@ -68,6 +69,12 @@ public:
 	template<T_Tags t_Tag>
 	TypeAt<t_Tag> const& Get() const { return std::get<( size_t )t_Tag>( m_data ); }
 
+	template<typename T_Fn>
+	decltype( auto ) Visit( T_Fn&& i_fn ) { return std::visit( std::forward<T_Fn>( i_fn ), m_data ); }
+
+	template<typename T_Fn>
+	decltype( auto ) Visit( T_Fn&& i_fn ) const { return std::visit( std::forward<T_Fn>( i_fn ), m_data ); }
+
 	friend bool operator==( NamedUnion const&, NamedUnion const& ) = default;
 	friend bool operator<( NamedUnion const& i_a, NamedUnion const& i_b ) { return i_a.m_data < i_b.m_data; }
 };
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "Containers.hpp"
+#include "Declare.hpp"
+#include "DebugUtils.hpp"
+
+#include <algorithm>
+
+namespace Riichi::StandardPayments
+{
+
+//------------------------------------------------------------------------------
+// What a win is paid under standard scoring, for every han and fu, worked out at compile time.
+// Payments are already rounded up to 100, so can be handed straight to the table,
+// or used to weigh up hypothetical wins without going through the rules.
+//------------------------------------------------------------------------------
+struct Payment
+{
+	// On ron the loser pays the total whoever they are, so all three are the same.
+	// On a dealer's tsumo everyone pays the dealer amount.
+	Points m_fromDealer;
+	Points m_fromNonDealer;
+	Points m_total;
+};
+
+// Counted yakuman, as anything more isn't distinguished
+// TODO-RULES: double/triple yakuman
+inline constexpr Han c_maxHan = 13;
+
+// Every fu a hand can score up to 250, past which even 1 han is mangan
+inline constexpr Array<Points, 25> c_fuBuckets = []()
+{
+	Array<Points, 25> buckets{ 20, 25 };
+	for ( size_t bucketI = 2; bucketI < buckets.size(); ++bucketI )
+	{
+		buckets[ bucketI ] = static_cast< Points >( bucketI * 10 + 10 );
+	}
+	return buckets;
+}();
+
+//------------------------------------------------------------------------------
+constexpr Points RoundTo100
+(
+	Points i_points
+)
+{
+	Points const rem = i_points % 100;
+	return rem > 0 ? i_points - rem + 100 : i_points;
+}
+
+//------------------------------------------------------------------------------
+constexpr size_t FuBucket
+(
+	Points i_fu
+)
+{
+	riEnsure( i_fu >= c_fuBuckets.front(), "Fu below minimum" );
+	if ( i_fu == 25 )
+	{
+		return 1;
+	}
+	Points const roundedFu = std::min( i_fu + ( 10 - ( i_fu % 10 ) ) % 10, c_fuBuckets.back() );
+	return roundedFu == 20 ? 0 : static_cast< size_t >( roundedFu / 10 - 1 );
+}
+
+//------------------------------------------------------------------------------
+constexpr Points BasicPoints
+(
+	Han i_han,
+	Points i_fu
+)
+{
+	if ( i_han >= 5 )
+	{
+		// Counted mangan
+		constexpr Points c_hanTable[] = {
+			2000, // 5 han mangan
+			3000, // 6 han haneman
+			3000, // 7 han haneman
+			4000, // 8 han baiman
+			4000, // 9 han baiman
+			4000, // 10 han baiman
+			6000, // 11 han sanbaiman
+			6000, // 12 han sanbaiman
+			8000, // 13 han yakuman
+		};
+
+		return c_hanTable[ std::min( i_han, c_maxHan ) - 5 ];
+	}
+
+	// TODO-RULES: kiriage mangan (round up to 2000 for 1920 points)
+	Points const base = ( i_fu * 4 ) << i_han;
+	return base >= 2000 ? 2000 : base;
+}
+
+//------------------------------------------------------------------------------
+constexpr Payment CalculatePayment
+(
+	Han i_han,
+	Points i_fu,
+	bool i_dealerWon,
+	bool i_tsumo
+)
+{
+	Points const basic = BasicPoints( i_han, i_fu );
+	if ( !i_tsumo )
+	{
+		Points const total = RoundTo100( ( i_dealerWon ? 6 : 4 ) * basic );
+		return { total, total, total };
+	}
+
+	Points const doubleBasic = RoundTo100( 2 * basic );
+	Points const singleBasic = i_dealerWon ? doubleBasic : RoundTo100( basic );
+	return { doubleBasic, singleBasic, doubleBasic + 2 * singleBasic };
+}
+
+//------------------------------------------------------------------------------
+constexpr size_t TableIndex
+(
+	Han i_han,
+	size_t i_fuBucket,
+	bool i_dealerWon,
+	bool i_tsumo
+)
+{
+	return ( ( ( ( std::min( i_han, c_maxHan ) * c_fuBuckets.size() ) + i_fuBucket ) * 2 + i_dealerWon ) * 2 ) + i_tsumo;
+}
+
+//------------------------------------------------------------------------------
+inline constexpr Array<Payment, ( c_maxHan + 1 ) * c_fuBuckets.size() * 2 * 2> c_table = []()
+{
+	Array<Payment, ( c_maxHan + 1 ) * c_fuBuckets.size() * 2 * 2> table{};
+	for ( Han han = 0; han <= c_maxHan; ++han )
+	{
+		for ( size_t fuI = 0; fuI < c_fuBuckets.size(); ++fuI )
+		{
+			for ( bool dealerWon : { false, true } )
+			{
+				for ( bool tsumo : { false, true } )
+				{
+					table[ TableIndex( han, fuI, dealerWon, tsumo ) ] = CalculatePayment( han, c_fuBuckets[ fuI ], dealerWon, tsumo );
+				}
+			}
+		}
+	}
+	return table;
+}();
+
+//------------------------------------------------------------------------------
+constexpr Payment const& Lookup
+(
+	Han i_han,
+	Points i_fu,
+	bool i_dealerWon,
+	bool i_tsumo
+)
+{
+	return c_table[ TableIndex( i_han, FuBucket( i_fu ), i_dealerWon, i_tsumo ) ];
+}
+
+static_assert( Lookup( 1, 30, false, false ).m_total == 1000 );
+static_assert( Lookup( 3, 25, true, false ).m_total == 4800 );
+static_assert( Lookup( 4, 30, false, true ).m_fromDealer == 3900 && Lookup( 4, 30, false, true ).m_fromNonDealer == 2000 );
+static_assert( Lookup( 26, 40, true, true ).m_total == 48000 );
+static_assert( c_fuBuckets.back() == 250 && BasicPoints( 1, c_fuBuckets.back() ) == 2000 );
+
+}
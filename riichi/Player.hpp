@@ -31,6 +31,17 @@ public:
 	Player( std::unique_ptr<AI::Agent>&& i_agent )
 		: m_aiAgent{ std::move( i_agent ) }
 	{}
+
+	// Same type of player, with its own copy of any agent. Empty if the agent can't be cloned.
+	Option<Player> Clone() const
+	{
+		if ( !m_aiAgent )
+		{
+			return Player{};
+		}
+		std::unique_ptr<AI::Agent> agent = m_aiAgent->Clone();
+		return agent ? Option<Player>( Player{ std::move( agent ) } ) : Option<Player>();
+	}
 };
 
 //------------------------------------------------------------------------------
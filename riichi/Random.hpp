@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <random>
 
 namespace Riichi
@@ -46,6 +47,23 @@ public:
 	friend bool operator==( RandomEngine const& i_a, RandomEngine const& i_b ) = default;
 };
 
+//------------------------------------------------------------------------------
+// SplitMix64, a tiny generator whose output is well mixed even for consecutive states.
+// Handy for deriving seeds and hash keys, rather than for shuffling.
+//------------------------------------------------------------------------------
+constexpr uint64_t SplitMix64Finalise( uint64_t i_value )
+{
+	i_value = ( i_value ^ ( i_value >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+	i_value = ( i_value ^ ( i_value >> 27 ) ) * 0x94d049bb133111ebull;
+	return i_value ^ ( i_value >> 31 );
+}
+
+constexpr uint64_t SplitMix64( uint64_t& io_state )
+{
+	io_state += 0x9e3779b97f4a7c15ull;
+	return SplitMix64Finalise( io_state );
+}
+
 //------------------------------------------------------------------------------
 using ShuffleRNG = RandomEngine<struct ShuffleRNGType>;
 using AIRNG = RandomEngine<struct AIRNGType>;
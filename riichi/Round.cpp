@@ -88,12 +88,12 @@ bool Round::RiichiIppatsuValid
 bool Round::Furiten
 (
 	Seat i_player,
-	Set<TileKind> const& i_waits
+	TileKindSet const& i_waits
 )	const
 {
 	PlayerData const& player = Player( i_player );
 	return player.m_tempFuriten
-		|| std::ranges::any_of( player.m_discards, [ & ]( TileInstance const& i_tile ) { return i_waits.contains( i_tile.Tile() ); } );
+		|| player.m_discardedKinds.Intersects( i_waits );
 }
 
 //------------------------------------------------------------------------------
@@ -114,6 +114,42 @@ Pair<Vector<TileInstance> const&, Option<size_t>> Round::VisibleDiscards
 	return { Player( i_player ).m_visibleDiscards, CalledRiichi( i_player ) ? Option<size_t>( Player( i_player ).m_riichi->m_sidewaysDiscardIndex ) : Option<size_t>() };
 }
 
+//------------------------------------------------------------------------------
+TileCounts Round::VisibleTileCounts
+(
+	Seat i_player
+)	const
+{
+	PlayerData const& player = Player( i_player );
+	TileCounts visible{ player.m_hand.FreeTiles() };
+	if ( player.m_draw.has_value() )
+	{
+		visible.Add( player.m_draw->m_tile.Tile() );
+	}
+
+	for ( PlayerData const& anyPlayer : m_players )
+	{
+		for ( TileInstance const& discard : anyPlayer.m_visibleDiscards )
+		{
+			visible.Add( discard.Tile() );
+		}
+		for ( Meld const& meld : anyPlayer.m_hand.Melds() )
+		{
+			for ( TileInstance const& tile : meld.Tiles() )
+			{
+				visible.Add( tile.Tile() );
+			}
+		}
+	}
+
+	for ( TileInstance const& indicator : GetDoraIndicatorTiles( false ) )
+	{
+		visible.Add( indicator.Tile() );
+	}
+
+	return visible;
+}
+
 //------------------------------------------------------------------------------
 Hand const& Round::CurrentHand
 (
@@ -123,6 +159,17 @@ Hand const& Round::CurrentHand
 	return Player( i_player ).m_hand;
 }
 
+//------------------------------------------------------------------------------
+HandAssessment const& Round::CurrentHandAssessment
+(
+	Seat i_player
+)	const
+{
+	PlayerData const& player = Player( i_player );
+	riEnsure( player.m_assessment.has_value(), "Hands are only assessed once dealt, and not between a call and its discard" );
+	return player.m_assessment.value();
+}
+
 //------------------------------------------------------------------------------
 Option<TileDraw> const& Round::CurrentTileDraw
 (
@@ -175,8 +222,8 @@ size_t Round::WallTilesRemaining
 (
 )	const
 {
-	riEnsure( m_wall.size() >= m_deadWallSize, "Wall decremented into dead wall! Oh no!" );
-	return m_wall.size() - m_deadWallSize;
+	riEnsure( m_wall.size() >= m_wallFront + m_deadWallSize, "Wall decremented into dead wall! Oh no!" );
+	return m_wall.size() - m_wallFront - m_deadWallSize;
 }
 
 //------------------------------------------------------------------------------
@@ -297,8 +344,8 @@ Vector<TileKind> Round::GetDoraTiles
 {
 	Vector<TileKind> doraTiles;
 
-	size_t firstDoraTileI = m_deadWallDrawsRemaining + 1;
-	size_t firstUradoraTileI = m_deadWallDrawsRemaining;
+	size_t firstDoraTileI = m_wallFront + m_deadWallDrawsRemaining + 1;
+	size_t firstUradoraTileI = m_wallFront + m_deadWallDrawsRemaining;
 
 	// TODO-RULES: using .Next() on the tile isn't great since e.g. sanma is missing tiles and would want to do it differently.
 
@@ -326,8 +373,8 @@ Vector<TileInstance> Round::GetDoraIndicatorTiles
 {
 	Vector<TileInstance> doraIndicatorTiles;
 
-	size_t firstDoraTileI = m_deadWallDrawsRemaining + 1;
-	size_t firstUradoraTileI = m_deadWallDrawsRemaining;
+	size_t firstDoraTileI = m_wallFront + m_deadWallDrawsRemaining + 1;
+	size_t firstUradoraTileI = m_wallFront + m_deadWallDrawsRemaining;
 
 	for ( size_t i = 0; i < m_doraCount; ++i )
 	{
@@ -353,7 +400,8 @@ Round::Round
 	Rules const& i_rules,
 	ShuffleRNG& i_shuffleRNG
 )
-	: m_deadWallSize{ i_rules.DeadWallSize() }
+	: m_rules{ &i_rules }
+	, m_deadWallSize{ i_rules.DeadWallSize() }
 	, m_deadWallDrawsRemaining{ i_rules.DeadWallDrawsAvailable() }
 {
 	riEnsure( i_playerIDs.size() == i_rules.GetPlayerCount(), "Did not provide enough players to start round" );
@@ -386,6 +434,7 @@ Round::Round
 	ShuffleRNG& i_shuffleRNG
 )
 	: m_initialPlayerID{ i_previousRound.m_initialPlayerID }
+	, m_rules{ &i_rules }
 	, m_deadWallSize{ i_rules.DeadWallSize() }
 	, m_deadWallDrawsRemaining{ i_rules.DeadWallDrawsAvailable() }
 	, m_roundWind{ i_previousRound.m_roundWind }
@@ -486,6 +535,12 @@ TileDraw Round::DealHands
 	{
 		m_players[ playerI ].m_hand.AddFreeTiles( DealTiles( 1 ) );
 	}
+
+	// Only assessed once fully dealt
+	for ( PlayerData& player : m_players )
+	{
+		HandChanged( player );
+	}
 	m_players.front().m_draw = SelfDraw();
 
 	return m_players.front().m_draw.value();
@@ -507,12 +562,26 @@ TileInstance Round::Discard
 		riEnsure( player.m_draw.has_value(), "Tried to discard drawn tile but didn't have one" );
 		return player.m_draw.value().m_tile;
 	}();
+
+	if ( JournalEntry* entry = Journal( JournalAction::Discard, m_currentTurn ) )
+	{
+		entry->m_tile = discarded;
+		entry->m_newDiscardedKind = !player.m_discardedKinds.Contains( discarded.Tile() );
+		if ( i_handTileToDiscard.has_value() )
+		{
+			entry->m_freeTileIndices = player.m_hand.FindFreeTiles( { discarded } );
+		}
+	}
+
 	player.m_discards.emplace_back( discarded );
+	player.m_discardedKinds.Insert( discarded.Tile() );
 	player.m_visibleDiscards.emplace_back( discarded );
 	if ( i_handTileToDiscard.has_value() )
 	{
 		player.m_hand.Discard( discarded, player.m_draw );
+		HandChanged( player );
 	}
+	// Otherwise the drawn tile was discarded, leaving the hand (and its assessment) as it was
 	player.m_draw.reset();
 
 	if ( player.m_riichi )
@@ -538,6 +607,10 @@ TileInstance Round::Riichi
 
 	// Set this after discarding to ensure discarding does not affect ippatsu
 	player.m_riichi = PlayerData::Riichi{ sidewaysDiscardIndex };
+	if ( m_journalling )
+	{
+		m_journal.back().m_declaredRiichi = true;
+	}
 
 	return discarded;
 }
@@ -548,13 +621,16 @@ TileDraw Round::PassCalls
 	SeatSet const& i_couldRon
 )
 {
+	Seat const nextPlayer = NextPlayer( m_currentTurn, m_players.size() );
+	Journal( JournalAction::PassCalls, nextPlayer );
+
 	for ( Seat seat : i_couldRon )
 	{
 		Player( seat ).m_tempFuriten = true;
 	}
 
 	bool constexpr c_callMade = false;
-	PlayerData& newPlayer = StartTurn( NextPlayer( m_currentTurn, m_players.size() ), c_callMade );
+	PlayerData& newPlayer = StartTurn( nextPlayer, c_callMade );
 
 	riEnsure( !newPlayer.m_draw, "Should not already have a drawn tile" );
 	newPlayer.m_draw = SelfDraw();
@@ -569,6 +645,17 @@ void Round::HandKan
 {
 	PlayerData& player = CurrentPlayer();
 
+	if ( JournalEntry* entry = Journal( JournalAction::HandKan, m_currentTurn ) )
+	{
+		entry->m_freeTileIndices = player.m_hand.FindFreeTiles( i_kanOption.m_freeHandTilesInvolved );
+		entry->m_closedQuad = i_kanOption.m_closed;
+		entry->m_drawAddedToHand = !i_kanOption.m_drawnTileInvolved.has_value();
+		if ( !i_kanOption.m_closed )
+		{
+			entry->m_tile = i_kanOption.Tiles().front();
+		}
+	}
+
 	Meld const& resultingMeld = player.m_hand.CallMeldFromHand( i_kanOption );
 	riEnsure( resultingMeld.Quad()
 		&& ( !resultingMeld.Open() == i_kanOption.m_closed )
@@ -588,6 +675,8 @@ void Round::HandKan
 		player.m_hand.AddFreeTiles( { player.m_draw->m_tile } );
 		player.m_draw.reset();
 	}
+
+	HandChanged( player );
 }
 
 //------------------------------------------------------------------------------
@@ -595,6 +684,11 @@ TileDraw Round::HandKanRonPass
 (
 )
 {
+	if ( JournalEntry* entry = Journal( JournalAction::HandKanRonPass, m_currentTurn ) )
+	{
+		entry->m_deadWallDraw = true;
+	}
+
 	// Invalidate riichi ippatsu as call made
 	for ( PlayerData& player : m_players )
 	{
@@ -624,15 +718,20 @@ Meld::CalledTile Round::Chi
 	TileInstance const calledDiscard = current.m_discards.back();
 	Seat const calledFrom = m_currentTurn;
 
+	PlayerData& caller = Player( i_caller );
+	if ( JournalEntry* entry = Journal( JournalAction::Call, i_caller ) )
+	{
+		entry->m_freeTileIndices = caller.m_hand.FindFreeTiles( i_chiOption.m_freeHandTilesInvolved );
+	}
+
 	// Disappear it from the visible discards in front of the player
 	current.m_visibleDiscards.pop_back();
-
-	PlayerData& caller = Player( i_caller );
 	Meld const& newMeld = caller.m_hand.CallMeld(
 		calledDiscard, calledFrom,
 		i_chiOption.m_freeHandTilesInvolved[ 0 ],
 		i_chiOption.m_freeHandTilesInvolved[ 1 ]
 	);
+	HandChanged( caller );
 
 	bool constexpr c_callMade = true;
 	StartTurn( i_caller, c_callMade );
@@ -653,15 +752,20 @@ Meld::CalledTile Round::Pon
 	TileInstance const calledDiscard = current.m_discards.back();
 	Seat const calledFrom = m_currentTurn;
 
+	PlayerData& caller = Player( i_caller );
+	if ( JournalEntry* entry = Journal( JournalAction::Call, i_caller ) )
+	{
+		entry->m_freeTileIndices = caller.m_hand.FindFreeTiles( i_ponOption.m_freeHandTilesInvolved );
+	}
+
 	// Disappear it from the visible discards in front of the player
 	current.m_visibleDiscards.pop_back();
-
-	PlayerData& caller = Player( i_caller );
 	Meld const& newMeld = caller.m_hand.CallMeld(
 		calledDiscard, calledFrom,
 		i_ponOption.m_freeHandTilesInvolved[ 0 ],
 		i_ponOption.m_freeHandTilesInvolved[ 1 ]
 	);
+	HandChanged( caller );
 
 	bool constexpr c_callMade = true;
 	StartTurn( i_caller, c_callMade );
@@ -682,11 +786,16 @@ Pair<TileDraw, Meld::CalledTile> Round::DiscardKan
 	TileInstance const calledDiscard = current.m_discards.back();
 	Seat const calledFrom = m_currentTurn;
 
+	PlayerData& caller = Player( i_caller );
+	if ( JournalEntry* entry = Journal( JournalAction::Call, i_caller ) )
+	{
+		entry->m_freeTileIndices = caller.m_hand.FindFreeTiles( i_kanOption.m_freeHandTilesInvolved );
+		entry->m_deadWallDraw = true;
+	}
+
 	// Disappear it from the visible discards in front of the player
 	current.m_visibleDiscards.pop_back();
 
-	PlayerData& caller = Player( i_caller );
-
 	// Make the meld
 	Meld const& newMeld = caller.m_hand.CallMeld(
 		calledDiscard, calledFrom,
@@ -694,6 +803,7 @@ Pair<TileDraw, Meld::CalledTile> Round::DiscardKan
 		i_kanOption.m_freeHandTilesInvolved[ 1 ],
 		i_kanOption.m_freeHandTilesInvolved[ 2 ]
 	);
+	HandChanged( caller );
 
 	bool constexpr c_callMade = true;
 	StartTurn( i_caller, c_callMade );
@@ -714,10 +824,123 @@ void Round::RiichiBetPaid
 	riEnsure( player.m_riichi, "Player must have already called riichi, to add a riichi stick" );
 	riEnsure( player.m_riichi->m_waitingToPayBet, "Player must not have already added a riichi stick" );
 
+	riEnsure( !m_journalling, "Riichi bets are paid to the table, so can't be undone by the round's journal" );
+
 	++m_riichiSticks;
 	player.m_riichi->m_waitingToPayBet = false;
 }
 
+//------------------------------------------------------------------------------
+void Round::StartJournal
+(
+	size_t i_reserveActions
+)
+{
+	m_journal.clear();
+	m_journal.reserve( i_reserveActions );
+	m_journalling = true;
+}
+
+//------------------------------------------------------------------------------
+void Round::StopJournal
+(
+)
+{
+	m_journal.clear();
+	m_journalling = false;
+}
+
+//------------------------------------------------------------------------------
+void Round::Undo
+(
+)
+{
+	riEnsure( !m_journal.empty(), "Nothing journalled to undo" );
+
+	JournalEntry& entry = m_journal.back();
+	PlayerData& player = Player( entry.m_seat );
+
+	switch ( entry.m_action )
+	{
+	case JournalAction::Discard:
+	{
+		TileInstance const& discarded = entry.m_tile.value();
+		player.m_discards.pop_back();
+		player.m_visibleDiscards.pop_back();
+		if ( entry.m_newDiscardedKind )
+		{
+			player.m_discardedKinds.Erase( discarded.Tile() );
+		}
+		if ( !entry.m_freeTileIndices.empty() )
+		{
+			player.m_hand.UndoDiscard( discarded, entry.m_freeTileIndices.front(), entry.m_previousDraw );
+			player.m_assessment = std::move( entry.m_previousAssessment );
+		}
+		if ( entry.m_declaredRiichi )
+		{
+			player.m_riichi.reset();
+		}
+		break;
+	}
+	case JournalAction::HandKan:
+	{
+		if ( entry.m_drawAddedToHand )
+		{
+			player.m_hand.RemoveFreeTile( entry.m_previousDraw.value().m_tile );
+		}
+		if ( entry.m_closedQuad )
+		{
+			player.m_hand.UndoMeld( entry.m_freeTileIndices );
+		}
+		else
+		{
+			player.m_hand.UndoUpgradedQuad( entry.m_tile.value(), entry.m_freeTileIndices );
+		}
+		player.m_assessment = std::move( entry.m_previousAssessment );
+		break;
+	}
+	case JournalAction::PassCalls:
+	{
+		// Back on the end of the wall it was drawn from, which still has the room for it
+		m_wall.push_back( player.m_draw.value().m_tile );
+		break;
+	}
+	case JournalAction::HandKanRonPass:
+	{
+		UndoDeadWallDraw();
+		break;
+	}
+	case JournalAction::Call:
+	{
+		if ( entry.m_deadWallDraw )
+		{
+			UndoDeadWallDraw();
+		}
+		player.m_hand.UndoMeld( entry.m_freeTileIndices );
+		player.m_assessment = std::move( entry.m_previousAssessment );
+
+		PlayerData& calledFrom = Player( entry.m_previousTurn );
+		calledFrom.m_visibleDiscards.push_back( calledFrom.m_discards.back() );
+		break;
+	}
+	}
+
+	// Everything else an action can touch is small enough to have been saved whole
+	player.m_draw = entry.m_previousDraw;
+	m_currentTurn = entry.m_previousTurn;
+	for ( size_t seatI = 0; seatI < m_players.size(); ++seatI )
+	{
+		PlayerData& seatPlayer = m_players[ seatI ];
+		seatPlayer.m_tempFuriten = ( entry.m_tempFuritenSeats >> seatI ) & 1u;
+		if ( seatPlayer.m_riichi )
+		{
+			seatPlayer.m_riichi->m_ippatsuValid = ( entry.m_ippatsuSeats >> seatI ) & 1u;
+		}
+	}
+
+	m_journal.pop_back();
+}
+
 //------------------------------------------------------------------------------
 TileInstance Round::AddWinner
 (
@@ -833,11 +1056,53 @@ TileDraw Round::DeadWallDraw
 	--m_deadWallDrawsRemaining;
 	++m_doraCount;
 
-	TileInstance drawn = std::move( m_wall.front() );
-	m_wall.erase( m_wall.begin() );
+	TileInstance drawn = m_wall[ m_wallFront ];
+	++m_wallFront;
 	return { drawn, TileDrawType::DeadWallDraw, };
 }
 
+//------------------------------------------------------------------------------
+void Round::UndoDeadWallDraw
+(
+)
+{
+	riEnsure( m_wallFront >= 1, "No dead wall draw to undo" );
+
+	--m_wallFront;
+	++m_deadWallDrawsRemaining;
+	--m_doraCount;
+}
+
+//------------------------------------------------------------------------------
+void Round::HandChanged
+(
+	PlayerData& io_player
+)
+{
+	// Keep the old assessment for undoing, as the action being journalled is the one changing the hand
+	if ( m_journalling )
+	{
+		riEnsure( &Player( m_journal.back().m_seat ) == &io_player, "Hand changed for a seat the journalled action wasn't for" );
+		m_journal.back().m_previousAssessment = std::move( io_player.m_assessment );
+	}
+
+	// After a chi or pon the hand has a tile too many to be waiting on anything, and nothing asks about it before the discard that follows
+	if ( io_player.m_hand.FreeTiles().size() % 3 != 1 )
+	{
+		io_player.m_assessment.reset();
+		return;
+	}
+
+	if ( m_evaluationCache )
+	{
+		io_player.m_assessment.emplace( m_evaluationCache->Assessment( *m_rules, io_player.m_hand ) );
+	}
+	else
+	{
+		io_player.m_assessment.emplace( io_player.m_hand, *m_rules );
+	}
+}
+
 //------------------------------------------------------------------------------
 Round::PlayerData& Round::StartTurn
 (
@@ -866,4 +1131,33 @@ Round::PlayerData& Round::StartTurn
 	return Player( i_player );
 }
 
+//------------------------------------------------------------------------------
+Round::JournalEntry* Round::Journal
+(
+	JournalAction i_action,
+	Seat i_seat
+)
+{
+	if ( !m_journalling )
+	{
+		return nullptr;
+	}
+
+	JournalEntry& entry = m_journal.emplace_back();
+	entry.m_action = i_action;
+	entry.m_seat = i_seat;
+	entry.m_previousTurn = m_currentTurn;
+	entry.m_previousDraw = Player( i_seat ).m_draw;
+	for ( size_t seatI = 0; seatI < m_players.size(); ++seatI )
+	{
+		PlayerData const& seatPlayer = m_players[ seatI ];
+		entry.m_tempFuritenSeats |= static_cast< uint8_t >( seatPlayer.m_tempFuriten ) << seatI;
+		if ( seatPlayer.m_riichi )
+		{
+			entry.m_ippatsuSeats |= static_cast< uint8_t >( seatPlayer.m_riichi->m_ippatsuValid ) << seatI;
+		}
+	}
+	return &entry;
+}
+
 }
@@ -7,6 +7,7 @@
 #include "Random.hpp"
 #include "Rules.hpp"
 #include "Seat.hpp"
+#include "TileKindSet.hpp"
 
 namespace Riichi
 {
@@ -37,15 +38,17 @@ public:
 
 	// These properties are per-player, and change as the round progresses:
 	Hand const& CurrentHand( Seat i_player ) const;
+	HandAssessment const& CurrentHandAssessment( Seat i_player ) const; // Built whenever the hand changes, so checks are free. Not available between a chi or pon and its discard
 	Option<TileDraw> const& CurrentTileDraw( Seat i_player ) const;
 	Vector<TileInstance> const& Discards( Seat i_player ) const;
 	Pair<Vector<TileInstance> const&, Option<size_t>> VisibleDiscards( Seat i_player ) const; // Discards still in front of the player, including index for a riichi tile
+	TileCounts VisibleTileCounts( Seat i_player ) const; // Every tile the player can see: their own hand, all discards and melds, and the dora indicators
 
 	bool CalledRiichi( Seat i_player ) const;
 	bool CalledDoubleRiichi( Seat i_player ) const;
 	bool WaitingToPayRiichiBet( Seat i_player ) const;
 	bool RiichiIppatsuValid( Seat i_player ) const;
-	bool Furiten( Seat i_player, Set<TileKind> const& i_waits ) const;
+	bool Furiten( Seat i_player, TileKindSet const& i_waits ) const;
 
 	// These properties are per-player, and are set when the round ends:
 	bool IsWinner( Seat i_player ) const;
@@ -80,6 +83,7 @@ public: // interface for the table states, which mutate the round state
 		Rules const& i_rules,
 		ShuffleRNG& i_shuffleRNG
 	);
+	void UseEvaluationCache( HandEvaluationCache* i_cache ) { m_evaluationCache = i_cache; }
 	TileDraw DealHands();
 
 	// Turn actions
@@ -93,6 +97,16 @@ public: // interface for the table states, which mutate the round state
 	Pair<TileDraw, Meld::CalledTile> DiscardKan( Seat i_caller, KanOption const& i_kanOption ); // returns dead wall draw ☠, called tile and called from
 	void RiichiBetPaid( Seat i_player ); // adds 1 riichi stick to the pot, and clears the payment-pending status of the given player
 
+	// Undo journal, for searches that play turn actions out on the round in place and then take them back.
+	// While journalling, each turn action above records just enough to undo it without copying hands or the wall.
+	// The exception is RiichiBetPaid, which can't be called while journalling: the bet's points are taken by the table, out of the round's reach.
+	// An action that changes a hand keeps its old assessment in the journal, so undoing puts it back rather than reassessing.
+	// Reserve room for the deepest line expected up front, and neither journalling nor undoing will allocate beyond the actions' own reassessments.
+	void StartJournal( size_t i_reserveActions );
+	void StopJournal(); // Forgets anything journalled so far
+	size_t JournalledActions() const { return m_journal.size(); }
+	void Undo(); // Rolls back the most recently journalled action
+
 	// Round finished actions
 	TileInstance AddWinner( Seat i_player, HandScore i_handScore, FinalScore i_finalScore ); // returns winning tile
 	void AddFinishedInTenpai( Seat i_player );
@@ -107,9 +121,11 @@ private:
 		PlayerID m_playerID; // index to Table's player list
 
 		Hand m_hand;
+		Option<HandAssessment> m_assessment; // Rebuilt by Round::HandChanged() whenever m_hand changes (and restored by Undo()), so reading a round never writes to it. Empty until dealt, and while a called hand has yet to discard
 		Option<TileDraw> m_draw; // Currently drawn tile
 		Vector<TileInstance> m_discards;
 		Vector<TileInstance> m_visibleDiscards; // Called tiles removed from this list
+		TileKindSet m_discardedKinds; // Every kind in m_discards, for furiten checks
 
 		struct Riichi
 		{
@@ -135,11 +151,14 @@ private:
 	};
 	PlayerID m_initialPlayerID;
 	Vector<PlayerData> m_players; // Sorted in seat order
+	Rules const* m_rules{ nullptr };
+	HandEvaluationCache* m_evaluationCache{ nullptr }; // Optional, owned by the table
 
 	// Wall is ordered in columns, clockwise from the dealer's right corner (initially), and reversed
-	// i.e. drawing is pop_back and dead wall is the 14 tiles at the start of the vector
+	// i.e. drawing is pop_back and dead wall is the 14 tiles from m_wallFront
 	// This makes it easy to draw, but complicates the maths a bit for wall breaking
 	Vector<TileInstance> m_wall;
+	size_t m_wallFront{ 0 }; // Dead wall draws step past tiles rather than erasing them, so they're cheap to undo
 	size_t m_breakPointFromDealerRight{ 0 }; // Unused other than for indicating to the user where to put the wall visuals
 	size_t m_deadWallSize{ 0 };
 	size_t m_deadWallDrawsRemaining{ 0 }; // This will decrement as dead wall draws are made
@@ -151,6 +170,34 @@ private:
 	size_t m_honbaSticks{ 0 };
 	size_t m_riichiSticks{ 0 };
 
+	enum class JournalAction : EnumValueType
+	{
+		Discard,
+		HandKan,
+		PassCalls,
+		HandKanRonPass,
+		Call, // Chi, pon, or kan on a discard
+	};
+	struct JournalEntry
+	{
+		JournalAction m_action{ JournalAction::Discard };
+		Seat m_seat{ Seat::East }; // Whoever the action was for: discarder, caller, or next to draw
+		Seat m_previousTurn{ Seat::East };
+		uint8_t m_tempFuritenSeats{ 0 }; // One bit per seat, from before the action
+		uint8_t m_ippatsuSeats{ 0 }; // One bit per seat, from before the action
+		Option<TileDraw> m_previousDraw; // The seat's drawn tile from before the action
+		Option<TileInstance> m_tile; // Discarded tile, or tile upgrading a quad
+		Hand::FreeTileIndices m_freeTileIndices; // Where any free tiles the action used were in the seat's hand
+		Option<HandAssessment> m_previousAssessment; // The seat's assessment from before the action, if it changed the hand
+		bool m_newDiscardedKind{ false };
+		bool m_declaredRiichi{ false };
+		bool m_closedQuad{ false };
+		bool m_drawAddedToHand{ false };
+		bool m_deadWallDraw{ false };
+	};
+	Vector<JournalEntry> m_journal;
+	bool m_journalling{ false };
+
 private:
 	PlayerData const& Player( Seat i_player ) const { return m_players[ ( size_t )i_player ]; }
 	PlayerData& Player( Seat i_player ) { return m_players[ ( size_t )i_player ]; }
@@ -161,6 +208,11 @@ private:
 	Vector<TileInstance> DealTiles( size_t i_num );
 	TileDraw SelfDraw();
 	TileDraw DeadWallDraw();
+	void HandChanged( PlayerData& io_player );
+	void UndoDeadWallDraw();
+
+	// Only records anything while journalling, returning null otherwise
+	JournalEntry* Journal( JournalAction i_action, Seat i_seat );
 
 	// Applies some common ops that need doing every time a new player starts their turn (to discard)
 	PlayerData& StartTurn( Seat i_player, bool i_callMade );
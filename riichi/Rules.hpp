@@ -3,14 +3,19 @@
 #include "Containers.hpp"
 #include "Declare.hpp"
 #include "HandInterpreter.hpp"
+#include "IDs.hpp"
 #include "PlayerCount.hpp"
 #include "Seat.hpp"
 #include "Tile.hpp"
+#include "TileKindSet.hpp"
 #include "Utils.hpp"
 #include "Yaku.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <numeric>
+#include <ranges>
 
 namespace Riichi
 {
@@ -21,10 +26,10 @@ struct HandScore
 	// Each of these values is usable however a ruleset wishes. None of them actually affect table points directly.
 	Points m_basicPoints;
 	Points m_fu;
-	Vector<Pair<char const*, HanValue>> m_yaku;
+	YakuValues m_yaku; // Names from Rules::YakuName
 
 	Points FuTotal() const { return m_fu; }
-	Han HanTotal() const { return std::accumulate( m_yaku.begin(), m_yaku.end(), 0, []( int a, auto const& yaku ) { return a + yaku.second.Get(); } ); }
+	Han HanTotal() const { return m_yaku.HanTotal(); }
 };
 struct FinalScore
 {
@@ -73,12 +78,15 @@ struct Rules
 	virtual bool HasPermissionToRiichi( Seat i_player, Points i_currentPoints ) const = 0; // mainly to vary whether players with negative points are allowed to riichi
 
 	// Hand evaluation
+	// Both take an assessment of i_hand, so that the one kept by the round can be reused rather than rebuilt.
+	// It must be of that exact hand, i.e. HandAssessment::Assesses( i_hand ).
 	// Returns valid waits for a win, and valid discards for riichi
-	virtual Pair<Set<TileKind>, Vector<TileInstance>> WaitsWithYaku
+	virtual Pair<TileKindSet, Vector<TileInstance>> WaitsWithYaku
 	(
 		Round const& i_round,
 		Seat const& i_playerSeat,
 		Hand const& i_hand,
+		HandAssessment const& i_assessment,
 		TileDraw const& i_lastTile,
 		bool i_considerForRiichi
 	) const = 0;
@@ -89,6 +97,16 @@ struct Rules
 		Round const& i_round,
 		Seat const& i_playerSeat,
 		Hand const& i_hand,
+		HandAssessment const& i_assessment,
+		TileDraw const& i_lastTile
+	) const = 0;
+
+	// Sums up everything besides the hand that this ruleset's yaku read, so that evaluations can be cached.
+	// Must differ whenever any yaku could give a different answer for the same hand.
+	virtual uint64_t YakuContextKey
+	(
+		Round const& i_round,
+		Seat const& i_playerSeat,
 		TileDraw const& i_lastTile
 	) const = 0;
 
@@ -114,27 +132,81 @@ struct Rules
 	virtual TablePayments ExhaustiveDrawPayments( SeatSet const& i_playersInTenpai ) const = 0; // paid on exhaustive draw
 
 	// Common to all rulesets
+	// Unique to this ruleset for the life of the program, unlike its address which can be reused once it's destroyed
+	RulesID ID() const { return m_id; }
 	inline auto Interpreters() const { return m_interpreters | DerefConst; }
+	char const* YakuName( YakuID i_yaku ) const { return m_yakuNames[ i_yaku ]; }
 	inline auto YakuEvaluators() const { return m_yakuEvaluators | DerefConst; }
+	inline auto YakuEvaluators( InterpreterID i_interpreter ) const { return m_interpreterYakuEvaluators[ i_interpreter ] | DerefConst; }
 
 protected:
 	template<std::derived_from<HandInterpreter> T_Interpreter, typename... Args>
 		requires std::constructible_from<T_Interpreter, Args...>
 	void AddInterpreter( Args&&... i_args )
 	{
-		m_interpreters.push_back( std::make_unique<T_Interpreter>( std::forward<Args>( i_args )... ) );
+		riEnsure( m_interpreters.size() < InterpreterID{}.GetValue(), "Too many interpreters to give IDs to" );
+		HandInterpreter& interpreter = *m_interpreters.emplace_back( std::make_unique<T_Interpreter>( std::forward<Args>( i_args )... ) );
+		interpreter.m_id = InterpreterID{ static_cast< InterpreterID::CoreType >( m_interpreters.size() - 1u ) };
+
+		// Pick up any evaluators that were added first
+		Vector<YakuEvaluator const*>& evaluators = m_interpreterYakuEvaluators.emplace_back();
+		for ( std::unique_ptr<YakuEvaluator> const& yaku : m_yakuEvaluators )
+		{
+			if ( yaku->UsesInterpreter( interpreter.Name() ) )
+			{
+				evaluators.push_back( yaku.get() );
+			}
+		}
 	}
 
 	template<std::derived_from<YakuEvaluator> T_Evaluator, typename... Args>
 		requires std::constructible_from<T_Evaluator, Args...>
 	void AddYakuEvaluator( Args&&... i_args )
 	{
-		m_yakuEvaluators.push_back( std::make_unique<T_Evaluator>( std::forward<Args>( i_args )... ) );
+		YakuEvaluator& yaku = *m_yakuEvaluators.emplace_back( std::make_unique<T_Evaluator>( std::forward<Args>( i_args )... ) );
+		yaku.m_id = AddYakuName( yaku.Name() );
+		for ( std::unique_ptr<HandInterpreter> const& interpreter : m_interpreters )
+		{
+			if ( yaku.UsesInterpreter( interpreter->Name() ) )
+			{
+				m_interpreterYakuEvaluators[ interpreter->ID() ].push_back( &yaku );
+			}
+		}
 	}
 
+	// Registers every yaku of a compile-time list in order, and tells the list which interpreter each one scores.
+	// Interpreters need adding first.
+	template<std::derived_from<YakuEvaluator>... T_Yaku>
+	void AddYakuList( YakuList<T_Yaku...>& io_list )
+	{
+		YakuID const firstID{ static_cast< YakuID::CoreType >( m_yakuNames.size() ) };
+		( AddYakuEvaluator<T_Yaku>(), ... );
+		io_list.Link( Interpreters(), firstID );
+	}
+
+	// For han that the ruleset counts itself rather than through an evaluator, e.g. dora, so that they can still be part of a score
+	YakuID AddCountedYaku( char const* i_name ) { return AddYakuName( i_name ); }
+
 private:
+	YakuID AddYakuName( char const* i_name )
+	{
+		riEnsure( m_yakuNames.size() < YakuValues::c_maxYaku, "Too many yaku to fit in a score" );
+		m_yakuNames.push_back( i_name );
+		return YakuID{ static_cast< YakuID::CoreType >( m_yakuNames.size() - 1u ) };
+	}
+
+	static RulesID NextID()
+	{
+		static std::atomic<RulesID::CoreType> s_nextID{ 0 };
+		return RulesID{ s_nextID++ };
+	}
+
+	RulesID m_id{ NextID() };
 	Vector<std::unique_ptr<HandInterpreter>> m_interpreters;
 	Vector<std::unique_ptr<YakuEvaluator>> m_yakuEvaluators;
+	TypeSafeIDArray<Vector<char const*>, YakuID> m_yakuNames; // Every yaku a score can hold, evaluated or counted
+	// Yaku that apply to each interpreter's interpretations, in the order they were added
+	TypeSafeIDArray<Vector<Vector<YakuEvaluator const*>>, InterpreterID> m_interpreterYakuEvaluators;
 };
 
 }
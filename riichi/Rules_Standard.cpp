@@ -1,6 +1,8 @@
 #include "Rules_Standard.hpp"
 
+#include "Payments_Standard.hpp"
 #include "Round.hpp"
+#include "Shanten.hpp"
 #include "Table.hpp"
 
 #include "HandInterpreter_Standard.hpp"
@@ -13,54 +15,14 @@ namespace Riichi
 StandardYonmaCore::StandardYonmaCore
 (
 )
+	: m_yakuList{ std::make_unique<StandardYaku::List>() }
 {
 	AddInterpreter<StandardInterpreter>();
 
-	{
-		using namespace StandardYaku;
-		AddYakuEvaluator<MenzenchinTsumohou>();
-		AddYakuEvaluator<Riichi>();
-		AddYakuEvaluator<Ippatsu>();
-		AddYakuEvaluator<Pinfu>();
-		AddYakuEvaluator<Iipeikou>();
-		AddYakuEvaluator<HaiteiRaoyue>();
-		AddYakuEvaluator<HouteiRaoyui>();
-		AddYakuEvaluator<RinshanKaihou>();
-		AddYakuEvaluator<Chankan>();
-		AddYakuEvaluator<Tanyao<>>();
-		AddYakuEvaluator<Yakuhai_Haku>();
-		AddYakuEvaluator<Yakuhai_Hatsu>();
-		AddYakuEvaluator<Yakuhai_Chun>();
-		AddYakuEvaluator<Bakaze>();
-		AddYakuEvaluator<Jikaze>();
-		AddYakuEvaluator<DoubleRiichi>();
-		AddYakuEvaluator<Chantaiyao>();
-		AddYakuEvaluator<SanshokuDoujun>();
-		AddYakuEvaluator<Ikkitsuukan>();
-		AddYakuEvaluator<Toitoi>();
-		AddYakuEvaluator<Sanankou>();
-		AddYakuEvaluator<SanshokuDoukou>();
-		AddYakuEvaluator<Sankantsu>();
-		AddYakuEvaluator<Chiitoitsu>();
-		AddYakuEvaluator<Honroutou>();
-		AddYakuEvaluator<Shousangen>();
-		AddYakuEvaluator<Honitsu>();
-		AddYakuEvaluator<JunchanTaiyao>();
-		AddYakuEvaluator<Ryanpeikou>();
-		AddYakuEvaluator<Chinitsu>();
-		AddYakuEvaluator<KokushiMusou>();
-		AddYakuEvaluator<Suuankou>();
-		AddYakuEvaluator<Daisangen>();
-		AddYakuEvaluator<Shousuushii>();
-		AddYakuEvaluator<Daisuushii>();
-		AddYakuEvaluator<Tsuuiisou>();
-		AddYakuEvaluator<Chinroutou>();
-		AddYakuEvaluator<Ryuuiisou>();
-		AddYakuEvaluator<ChuurenPoutou>();
-		AddYakuEvaluator<Suukantsu>();
-		AddYakuEvaluator<Tenhou>();
-		AddYakuEvaluator<Chihou>();
-	}
+	AddYakuList( *m_yakuList );
+	m_doraID = AddCountedYaku( "Dora" );
+	m_uradoraID = AddCountedYaku( "Uradora" );
+	m_akadoraID = AddCountedYaku( "Akadora" );
 
 	// Set up properties, namely akadora
 	RegisterTileProperties(
@@ -100,15 +62,23 @@ StandardYonmaCore::StandardYonmaCore
 }
 
 //------------------------------------------------------------------------------
-Pair<Set<TileKind>, Vector<TileInstance>> StandardYonmaCore::WaitsWithYaku
+StandardYonmaCore::~StandardYonmaCore
+(
+) = default;
+
+//------------------------------------------------------------------------------
+Pair<TileKindSet, Vector<TileInstance>> StandardYonmaCore::WaitsWithYaku
 (
 	Round const& i_round,
 	Seat const& i_playerSeat,
 	Hand const& i_hand,
+	HandAssessment const& i_assessment,
 	TileDraw const& i_lastTile,
 	bool i_considerForRiichi
 ) const
 {
+	riEnsure( i_assessment.Assesses( i_hand ), "Assessment is of a different hand" );
+
 	// Closed kan theft is not allowed for a win
 	// TODO-RULES: some rulesets allow closed kan theft for thirteen orphans
 	if ( i_lastTile.m_type == TileDrawType::ClosedKanTheft )
@@ -116,103 +86,146 @@ Pair<Set<TileKind>, Vector<TileInstance>> StandardYonmaCore::WaitsWithYaku
 		return {};
 	}
 
-	bool riichiAddsYaku = false;
 	Vector<TileInstance> validDiscardsForRiichi;
-
-	auto fnAddDiscardsForRiichi = [ & ]( HandAssessment const& i_assessment, HandInterpretation const& i_interp, TileInstance const& i_discardedTile )
+	if ( i_considerForRiichi )
 	{
-		if ( !i_considerForRiichi || i_interp.m_waitType == WaitType::None )
+		for ( RiichiDiscard const& discard : RiichiDiscards( i_round, i_playerSeat, i_hand, i_assessment, i_lastTile ) )
 		{
-			return;
+			validDiscardsForRiichi.push_back( discard.m_tile );
 		}
-		if ( riichiAddsYaku )
+	}
+
+	TileKindSet waits;
+	for ( HandInterpretation const& interp : i_assessment.Interpretations() )
+	{
+		if ( interp.m_waitType == WaitType::None || !interp.m_waits.Contains( i_lastTile.m_tile.Tile() ) )
 		{
-			validDiscardsForRiichi.push_back( i_discardedTile );
-			return;
+			continue;
 		}
 
-		for ( YakuEvaluator const& yaku : YakuEvaluators() )
+		if ( m_yakuList->AnyValid(
+			i_round,
+			i_playerSeat,
+			i_hand,
+			i_assessment,
+			interp,
+			i_lastTile.m_tile.Tile(),
+			i_lastTile.m_type
+		) )
 		{
-			if ( yaku.UsesInterpreter( i_interp.m_interpreter ) )
-			{
-				if ( yaku.CalculateValue(
-					i_round,
-					i_playerSeat,
-					i_hand,
-					i_assessment,
-					i_interp,
-					*i_interp.m_waits.begin(),
-					TileDrawType::DiscardDraw
-				).IsValid() )
-				{
-					validDiscardsForRiichi.push_back( i_discardedTile );
-				}
-			}
+			waits |= interp.m_waits;
 		}
-	};
+	}
 
-	if ( i_considerForRiichi )
+	return { std::move( waits ), std::move( validDiscardsForRiichi ) };
+}
+
+//------------------------------------------------------------------------------
+Vector<RiichiDiscard> StandardYonmaCore::RiichiDiscards
+(
+	Round const& i_round,
+	Seat const& i_playerSeat,
+	Hand const& i_hand,
+	HandAssessment const& i_assessment,
+	TileDraw const& i_lastTile
+)	const
+{
+	bool riichiAddsYaku = false;
+	for ( YakuEvaluator const& yaku : YakuEvaluators() )
 	{
-		for ( YakuEvaluator const& yaku : YakuEvaluators() )
+		if ( yaku.AddsYakuToRiichi() )
 		{
-			if ( yaku.AddsYakuToRiichi() )
-			{
-				riichiAddsYaku = true;
-				break;
-			}
+			riichiAddsYaku = true;
+			break;
 		}
+	}
 
-		// TODO-DEBT TODO-OPT: I've decided the easiest code to write here is to assess all discard options to see if there are any waits
-		// but this is probably the worst way to do it
+	// The waits left behind by a discard, keeping only those that come with a yaku
+	auto fnWaitsWithYaku = [ & ]( HandAssessment const& i_discardAssessment )
+	{
+		if ( riichiAddsYaku )
+		{
+			return i_discardAssessment.Waits();
+		}
 
-		for ( TileInstance const& tile : i_hand.FreeTiles() )
+		TileKindSet waits;
+		for ( HandInterpretation const& interp : i_discardAssessment.Interpretations() )
 		{
-			Hand alteredHand = i_hand;
-			alteredHand.Discard( tile, i_lastTile );
-			HandAssessment const assessment( alteredHand, *this );
+			if ( interp.m_waitType == WaitType::None )
+			{
+				continue;
+			}
 
-			for ( HandInterpretation const& interp : assessment.Interpretations() )
+			if ( m_yakuList->AnyValid(
+				i_round,
+				i_playerSeat,
+				i_hand,
+				i_discardAssessment,
+				interp,
+				*interp.m_waits.begin(),
+				TileDrawType::DiscardDraw
+			) )
 			{
-				fnAddDiscardsForRiichi( assessment, interp, tile );
+				waits |= interp.m_waits;
 			}
 		}
+		return waits;
+	};
 
+	// Every discard leaves the same melds and all but one of the same tiles, so work from the counts of the whole hand.
+	// Discarding any copy of a kind leaves the same hand, so each kind only needs considering once.
+	TileCounts allFreeTiles = i_assessment.FreeTileCounts();
+	allFreeTiles.Add( i_lastTile.m_tile.Tile() );
+	size_t const meldCount = i_hand.Melds().size();
+
+	// Shanten can't see waits on a fifth copy of a tile, so only trust it to rule discards out when there's no kind held four times
+	bool const shantenIsExact = allFreeTiles.KindMask( 4 ) == 0;
+	if ( shantenIsExact && Shanten( allFreeTiles, meldCount ) > 0 )
+	{
+		return {};
 	}
 
-	// Let's  a s s e s s
-	HandAssessment const assessment( i_hand, *this );
+	// While shanten is exact, one shared pass over the counts gives every discard's waits without assessing any of them, as these rules only interpret standard hands.
+	// Only the yaku check, or a kind held four times, still needs a discard's own assessment, and then only for discards left in tenpai.
+	Array<TileKindSet, TileKindIndex::c_count> const sharedWaits = shantenIsExact
+		? WaitsAfterDiscards( allFreeTiles, meldCount )
+		: Array<TileKindSet, TileKindIndex::c_count>{};
 
-	Set<TileKind> waits;
-	for ( HandInterpretation const& interp : assessment.Interpretations() )
+	Array<Option<TileKindSet>, TileKindIndex::c_count> waitsPerKind;
+	auto fnWaitsAfterDiscarding = [ & ]( Tile const& i_discard ) -> TileKindSet const&
 	{
-		fnAddDiscardsForRiichi( assessment, interp, i_lastTile.m_tile );
-
-		if ( interp.m_waitType == WaitType::None || !interp.m_waits.contains( i_lastTile.m_tile.Tile() ) )
+		TileKindIndex const kind{ i_discard };
+		if ( !waitsPerKind[ kind ].has_value() )
 		{
-			continue;
+			if ( TileKindIndex{ i_lastTile.m_tile.Tile() } == kind )
+			{
+				// Same as letting the drawn tile go, which is the assessment we already have
+				waitsPerKind[ kind ] = fnWaitsWithYaku( i_assessment );
+			}
+			else if ( shantenIsExact && ( riichiAddsYaku || sharedWaits[ kind ].Empty() ) )
+			{
+				waitsPerKind[ kind ] = sharedWaits[ kind ];
+			}
+			else
+			{
+				TileCounts remaining = allFreeTiles;
+				remaining.Remove( i_discard );
+				waitsPerKind[ kind ] = fnWaitsWithYaku( HandAssessment( i_hand, remaining, *this ) );
+			}
 		}
+		return *waitsPerKind[ kind ];
+	};
 
-		for ( YakuEvaluator const& yaku : YakuEvaluators() )
+	Vector<RiichiDiscard> discards;
+	for ( TileInstance const& tile : MaybeAppendTileInstance( i_hand.FreeTiles(), i_lastTile.m_tile ) )
+	{
+		TileKindSet const& waits = fnWaitsAfterDiscarding( tile.Tile() );
+		if ( !waits.Empty() )
 		{
-			if ( yaku.UsesInterpreter( interp.m_interpreter ) )
-			{
-				if ( yaku.CalculateValue(
-					i_round,
-					i_playerSeat,
-					i_hand,
-					assessment,
-					interp,
-					i_lastTile.m_tile.Tile(),
-					i_lastTile.m_type
-				).IsValid() )
-				{
-					std::ranges::for_each( interp.m_waits, [ & ]( TileKind kind ) { waits.insert( kind ); } );
-				}
-			}
+			discards.push_back( { tile, waits } );
 		}
 	}
-
-	return { std::move( waits ), std::move( validDiscardsForRiichi ) };
+	return discards;
 }
 
 //------------------------------------------------------------------------------
@@ -221,51 +234,45 @@ HandScore StandardYonmaCore::CalculateBasicPoints
 	Round const& i_round,
 	Seat const& i_playerSeat,
 	Hand const& i_hand,
+	HandAssessment const& i_assessment,
 	TileDraw const& i_lastTile
 ) const
 {
-	// Let's  a s s e s s
-	HandAssessment const assessment( i_hand, *this );
+	riEnsure( i_assessment.Assesses( i_hand ), "Assessment is of a different hand" );
 
+	// Yakuman are tried first, and an interpretation is given up on as soon as it can no longer reach the best so far.
+	// Later interpretations win ties, so only those that can't even match it are skipped, keeping the result the same as trying everything.
 	Han max = 0;
-	Vector<Pair<char const*, HanValue>> maxScore;
+	YakuValues maxValues;
+	YakuValues interpValues;
 	HandInterpretation const* maxInterp{ nullptr };
-	for ( HandInterpretation const& interp : assessment.Interpretations() )
+	for ( HandInterpretation const& interp : i_assessment.Interpretations() )
 	{
-		if ( !interp.m_waits.contains( i_lastTile.m_tile.Tile() ) )
+		if ( !interp.m_waits.Contains( i_lastTile.m_tile.Tile() ) )
 		{
 			continue;
 		}
 
 		Han total = 0;
-		Vector<Pair<char const*, HanValue>> interpScore;
-		for ( YakuEvaluator const& yaku : YakuEvaluators() )
-		{
-			if ( yaku.UsesInterpreter( interp.m_interpreter ) )
-			{
-				HanValue const value = yaku.CalculateValue(
-					i_round,
-					i_playerSeat,
-					i_hand,
-					assessment,
-					interp,
-					i_lastTile.m_tile.Tile(),
-					i_lastTile.m_type
-				);
-
-				if ( value.IsValid() )
-				{
-					interpScore.push_back( { yaku.Name(), value } );
-					total += value.Get();
-				}
-			}
-		}
+		interpValues.Clear();
+		bool const canMatchMax = m_yakuList->Evaluate(
+			max,
+			total,
+			interpValues,
+			i_round,
+			i_playerSeat,
+			i_hand,
+			i_assessment,
+			interp,
+			i_lastTile.m_tile.Tile(),
+			i_lastTile.m_type
+		);
 
 		// TODO-RULES: Specify other possibilities for superseding
-		if ( max <= total )
+		if ( canMatchMax && max <= total )
 		{
 			max = total;
-			maxScore = std::move( interpScore );
+			maxValues = interpValues;
 			maxInterp = &interp;
 		}
 	}
@@ -277,65 +284,39 @@ HandScore StandardYonmaCore::CalculateBasicPoints
 
 	riEnsure( maxInterp, "Had max points more than 0 but no valid interpretation" );
 
-	auto fnHandHasYaku = [ & ]( char const* i_yakuName )
-	{
-		return std::ranges::any_of( maxScore, [ & ]( auto const& yaku ) { return std::strcmp( yaku.first, i_yakuName ) == 0; } );
-	};
-
 	// Handle Dora
 	{
 		bool constexpr c_indicatedValue = true;
-		bool const includeUradora = fnHandHasYaku( "Riichi" ) || fnHandHasYaku( "DoubleRiichi" );
+		bool const includeUradora = maxValues.Contains( m_yakuList->ID<StandardYaku::Riichi>() ) || maxValues.Contains( m_yakuList->ID<StandardYaku::DoubleRiichi>() );
 		Vector<TileKind> const doraTiles = i_round.GetDoraTiles( includeUradora );
 
-		Han doraValue{ 0 };
-		Han uradoraValue{ 0 };
-		Han akadoraValue{ 0 };
-
-		size_t const doraBegin = 0;
+		// Each indicated kind is worth a han for every copy held, and a kind indicated twice counts twice
+		TileCounts doraKinds;
+		TileCounts uradoraKinds;
 		size_t const doraEnd = doraTiles.size() / ( includeUradora ? 2 : 1 );
-		size_t const uradoraBegin = doraEnd;
-		size_t const uradoraEnd = doraTiles.size();
+		for ( size_t i = 0; i < doraTiles.size(); ++i )
+		{
+			( i < doraEnd ? doraKinds : uradoraKinds ).Add( doraTiles[ i ] );
+		}
 
-		std::ranges::for_each(
-			MaybeAppendTileInstance( i_hand.AllTiles(), i_lastTile.m_tile ),
-			[ & ]( TileInstance const& i_tile )
-			{
-				EqualsTileKind const sharesTileKind{ i_tile };
-				for ( size_t i = doraBegin; i < doraEnd; ++i )
-				{
-					if ( sharesTileKind( doraTiles[ i ] ) )
-					{
-						++doraValue;
-					}
-				}
-				for ( size_t i = uradoraBegin; i < uradoraEnd; ++i )
-				{
-					if ( sharesTileKind( doraTiles[ i ] ) )
-					{
-						++uradoraValue;
-					}
-				}
-				if ( i_tile.Tile().HasProperty<Akadora>() )
-				{
-					++akadoraValue;
-				}
-			}
-		);
+		TileCounts const handTiles{ MaybeAppendTileInstance( i_hand.AllTiles(), i_lastTile.m_tile ) };
+		Han const doraValue = static_cast< Han >( handTiles.CountMatches( doraKinds ) );
+		Han const uradoraValue = static_cast< Han >( handTiles.CountMatches( uradoraKinds ) );
+		Han const akadoraValue = handTiles.AkadoraCount();
 
 		if ( doraValue > 0 )
 		{
-			maxScore.push_back( { "Dora", doraValue } );
+			maxValues.Add( m_doraID, doraValue );
 			max += doraValue;
 		}
 		if ( uradoraValue > 0 )
 		{
-			maxScore.push_back( { "Uradora", uradoraValue } );
+			maxValues.Add( m_uradoraID, uradoraValue );
 			max += uradoraValue;
 		}
 		if ( akadoraValue > 0 )
 		{
-			maxScore.push_back( { "Akadora", akadoraValue } );
+			maxValues.Add( m_akadoraID, akadoraValue );
 			max += akadoraValue;
 		}
 	}
@@ -419,7 +400,7 @@ HandScore StandardYonmaCore::CalculateBasicPoints
 	}
 
 	// Win condition
-	bool const wonWithPinfu = fnHandHasYaku( "Pinfu" );
+	bool const wonWithPinfu = maxValues.Contains( m_yakuList->ID<StandardYaku::Pinfu>() );
 	switch ( i_lastTile.m_type )
 	{
 	using enum TileDrawType;
@@ -439,7 +420,7 @@ HandScore StandardYonmaCore::CalculateBasicPoints
 	case UpgradedKanTheft:
 	{
 		// Ron
-		if ( !assessment.m_open )
+		if ( !i_assessment.m_open )
 		{
 			fu += 10;
 		}
@@ -447,7 +428,7 @@ HandScore StandardYonmaCore::CalculateBasicPoints
 	}
 	}
 
-	bool const wonWithChiitoitsu = fnHandHasYaku( "Chiitoitsu" );
+	bool const wonWithChiitoitsu = maxValues.Contains( m_yakuList->ID<StandardYaku::Chiitoitsu>() );
 	if ( wonWithChiitoitsu )
 	{
 		fu = 25;
@@ -463,44 +444,42 @@ HandScore StandardYonmaCore::CalculateBasicPoints
 	}
 
 	// "open pinfu" set to 30
-	if ( assessment.m_open && fu == 20 )
+	if ( i_assessment.m_open && fu == 20 )
 	{
 		fu = 30;
 	}
 
-	Points const basePoints = [ & ]()
-	{
-		if ( max >= 5 )
-		{
-			// Counted mangan
-			// TODO-RULES: double/triple yakuman
-			static Points constexpr c_hanTable[] = {
-				2000, // 5 han mangan
-				3000, // 6 han haneman
-				3000, // 7 han haneman
-				4000, // 8 han baiman
-				4000, // 9 han baiman
-				4000, // 10 han baiman
-				6000, // 11 han sanbaiman
-				6000, // 12 han sanbaiman
-				8000, // 13 han yakuman
-			};
-
-			return c_hanTable[ std::min<Han>( max, 13 ) - 5 ];
-		}
-
-		Points base = fu * 4;
-		Han han = max;
-		while ( han-- )
-		{
-			base *= 2;
-		}
+	return { StandardPayments::BasicPoints( max, fu ), fu, maxValues };
+}
 
-		// TODO-RULES: kirage mangan (round up to 2000 for 1920 points)
-		return base >= 2000 ? 2000 : base;
-	}();
+//------------------------------------------------------------------------------
+uint64_t StandardYonmaCore::YakuContextKey
+(
+	Round const& i_round,
+	Seat const& i_playerSeat,
+	TileDraw const& i_lastTile
+)	const
+{
+	// Everything the standard yaku read from the round fits comfortably into separate bits, so there are no collisions
+	uint64_t key = 0;
+	auto fnPack = [ &key ]( uint64_t i_value, size_t i_bits )
+	{
+		riEnsure( i_value < ( uint64_t{ 1 } << i_bits ), "Context value doesn't fit its bits" );
+		key = ( key << i_bits ) | i_value;
+	};
 
-	return { basePoints, fu, std::move( maxScore ) };
+	fnPack( static_cast< EnumValueType >( i_playerSeat ), 2 );
+	fnPack( static_cast< EnumValueType >( i_round.Wind() ), 2 );
+	fnPack( i_round.CalledRiichi( i_playerSeat ), 1 );
+	fnPack( i_round.CalledDoubleRiichi( i_playerSeat ), 1 );
+	fnPack( i_round.RiichiIppatsuValid( i_playerSeat ), 1 );
+	fnPack( i_round.CallsMade(), 1 );
+	fnPack( i_round.Discards( i_playerSeat ).empty(), 1 );
+	fnPack( i_round.WallTilesRemaining() == 0u, 1 );
+	fnPack( static_cast< EnumValueType >( i_lastTile.m_type ), 4 );
+	fnPack( TileKindIndex{ i_lastTile.m_tile.Tile() }, 8 );
+	fnPack( i_lastTile.m_tile.Tile().Bits(), 8 );
+	return key;
 }
 
 //------------------------------------------------------------------------------
@@ -616,7 +595,7 @@ TablePayments StandardYonmaCore::RiichiBetPotPayments
 	}
 
 	// The riichi bet is already paid, so this is adding points to the winners only, by dividing what's in the pot evenly
-	Points const riichiBetPayment = RoundTo100( static_cast< Points >( ( i_riichiSticks * RiichiBetPoints() ) / i_winners.Size() ) );
+	Points const riichiBetPayment = StandardPayments::RoundTo100( static_cast< Points >( ( i_riichiSticks * RiichiBetPoints() ) / i_winners.Size() ) );
 
 	TablePayments payments;
 
@@ -636,20 +615,17 @@ TablePayments StandardYonmaCore::TsumoPayments
 )	const
 {
 	TablePayments payments;
-	bool const winnerIsDealer = ( i_winner == Seat::East );
-
-	Points const doubleBasic = RoundTo100( 2 * i_handScore.m_basicPoints );
-	Points const singleBasic = RoundTo100( i_handScore.m_basicPoints );
+	StandardPayments::Payment const& payment = StandardPayments::Lookup( i_handScore.HanTotal(), i_handScore.FuTotal(), i_winner == Seat::East, true );
 
 	for ( Seat seat : Seats{} )
 	{
 		if ( seat == i_winner )
 		{
-			payments.m_pointsPerSeat[ seat ] = doubleBasic + ( 2 * ( winnerIsDealer ? doubleBasic : singleBasic ) );
+			payments.m_pointsPerSeat[ seat ] = payment.m_total;
 		}
 		else
 		{
-			payments.m_pointsPerSeat[ seat ] = ( seat == Seat::East || winnerIsDealer ) ? -doubleBasic : -singleBasic;
+			payments.m_pointsPerSeat[ seat ] = ( seat == Seat::East ) ? -payment.m_fromDealer : -payment.m_fromNonDealer;
 		}
 	}
 
@@ -665,9 +641,7 @@ TablePayments StandardYonmaCore::RonPayments
 )	const
 {
 	TablePayments payments;
-	bool const winnerIsDealer = ( i_winner == Seat::East );
-
-	payments.m_pointsPerSeat[ i_winner ] = RoundTo100( ( winnerIsDealer ? 6 : 4 ) * i_handScore.m_basicPoints );
+	payments.m_pointsPerSeat[ i_winner ] = StandardPayments::Lookup( i_handScore.HanTotal(), i_handScore.FuTotal(), i_winner == Seat::East, false ).m_total;
 	payments.m_pointsPerSeat[ i_loser ] = -payments.m_pointsPerSeat[ i_winner ];
 
 	return payments;
@@ -701,18 +675,4 @@ TablePayments StandardYonmaCore::ExhaustiveDrawPayments
 	return payments;
 }
 
-//------------------------------------------------------------------------------
-/*static*/ Points StandardYonmaCore::RoundTo100
-(
-	Points i_finalPoints
-)
-{
-	Points const rem = i_finalPoints % 100;
-	if ( rem > 0 )
-	{
-		return i_finalPoints - rem + 100;
-	}
-	return i_finalPoints;
-}
-
 }
\ No newline at end of file
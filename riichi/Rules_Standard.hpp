@@ -3,16 +3,37 @@
 #include "Rules.hpp"
 #include "Seat.hpp"
 
+#include <memory>
+
 namespace Riichi
 {
 
+namespace StandardYaku
+{
+struct List;
+}
+
+//------------------------------------------------------------------------------
+// A discard that leaves a hand waiting on a win with yaku, and what it then waits on
+//------------------------------------------------------------------------------
+struct RiichiDiscard
+{
+	TileInstance m_tile;
+	TileKindSet m_waits;
+};
+
 //------------------------------------------------------------------------------
 class StandardYonmaCore
 	: public Rules
 {
 	Vector<TileInstance> m_tileSet;
+	std::unique_ptr<StandardYaku::List> m_yakuList; // Same yaku as registered, for scoring without virtual calls
+	YakuID m_doraID;
+	YakuID m_uradoraID;
+	YakuID m_akadoraID;
 public:
 	StandardYonmaCore();
+	~StandardYonmaCore() override;
 
 	size_t GetPlayerCount() const override { return 4_Players; }
 	Points InitialPoints() const override { return 25'000; }
@@ -21,11 +42,12 @@ public:
 	size_t DeadWallDrawsAvailable() const override { return 4u; }
 	bool HasPermissionToRiichi( Seat i_player, Points i_currentPoints ) const override { return i_currentPoints >= RiichiBetPoints(); }
 
-	Pair<Set<TileKind>, Vector<TileInstance>> WaitsWithYaku
+	Pair<TileKindSet, Vector<TileInstance>> WaitsWithYaku
 	(
 		Round const& i_round,
 		Seat const& i_playerSeat,
 		Hand const& i_hand,
+		HandAssessment const& i_assessment,
 		TileDraw const& i_lastTile,
 		bool i_considerForRiichi
 	) const override;
@@ -35,6 +57,25 @@ public:
 		Round const& i_round,
 		Seat const& i_playerSeat,
 		Hand const& i_hand,
+		HandAssessment const& i_assessment,
+		TileDraw const& i_lastTile
+	) const override;
+
+	// Every free tile or the drawn tile that could be discarded to riichi, each with the waits it leaves.
+	// Takes every discard's waits from one shared pass over the hand's counts, only assessing a discard when its waits need a yaku check or a kind is held four times.
+	Vector<RiichiDiscard> RiichiDiscards
+	(
+		Round const& i_round,
+		Seat const& i_playerSeat,
+		Hand const& i_hand,
+		HandAssessment const& i_assessment,
+		TileDraw const& i_lastTile
+	) const;
+
+	uint64_t YakuContextKey
+	(
+		Round const& i_round,
+		Seat const& i_playerSeat,
 		TileDraw const& i_lastTile
 	) const override;
 
@@ -47,9 +88,6 @@ public:
 	TablePayments TsumoPayments( HandScore const& i_handScore, Seat i_winner ) const override;
 	TablePayments RonPayments( HandScore const& i_handScore, Seat i_winner, Seat i_loser ) const override;
 	TablePayments ExhaustiveDrawPayments( SeatSet const& i_playersInTenpai ) const override;
-
-private:
-	static Points RoundTo100( Points i_finalPoints );
 };
 
 //------------------------------------------------------------------------------
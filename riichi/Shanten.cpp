@@ -0,0 +1,669 @@
+#include "Shanten.hpp"
+
+#include "Hand.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+namespace Riichi::Detail
+{
+
+//------------------------------------------------------------------------------
+// Distances for a suit are packed 4 bits per entry into a single word, so that a
+// table entry can be published atomically without any locking.
+// The top bit marks that the entry has been filled in.
+//------------------------------------------------------------------------------
+static constexpr size_t c_maxCopies = 4;
+static constexpr size_t c_countBase = c_maxCopies + 1;
+static constexpr size_t c_entryBits = 4;
+static constexpr uint64_t c_entryMask = ( 1 << c_entryBits ) - 1;
+static constexpr uint64_t c_filledBit = uint64_t{ 1 } << 63;
+
+static constexpr size_t PatternCount( size_t i_kindCount )
+{
+	size_t count = 1;
+	for ( size_t i = 0; i < i_kindCount; ++i )
+	{
+		count *= c_countBase;
+	}
+	return count;
+}
+
+static std::atomic<uint64_t> s_numberSuitTable[ PatternCount( Numbers::Count() ) ];
+static std::atomic<uint64_t> s_honourTable[ PatternCount( Honours::Count() ) ];
+
+//------------------------------------------------------------------------------
+static SuitDistances CalculateDistances
+(
+	Span<uint8_t const> i_have,
+	bool i_allowSequences
+)
+{
+	// Walk the faces in order, tracking how many sequences are still waiting on this face.
+	// A sequence started at face i needs a tile at i, i+1 and i+2, so at most two "generations" are ever open.
+	// State is [ groups ][ pair ][ sequences started last face ][ sequences started the face before ]
+	using Costs = Array<Array<Array<Array<uint8_t, c_countBase>, c_countBase>, 2>, SuitDistances::c_maxGroups + 1>;
+	uint8_t constexpr c_unreachable = std::numeric_limits<uint8_t>::max();
+
+	Costs costs;
+	for ( auto& byPair : costs ) for ( auto& byLast : byPair ) for ( auto& byPrev : byLast ) byPrev.fill( c_unreachable );
+	costs[ 0 ][ 0 ][ 0 ][ 0 ] = 0;
+
+	for ( size_t faceI = 0; faceI < i_have.size(); ++faceI )
+	{
+		Costs next;
+		for ( auto& byPair : next ) for ( auto& byLast : byPair ) for ( auto& byPrev : byLast ) byPrev.fill( c_unreachable );
+
+		bool const canStartSequence = i_allowSequences && faceI + 2 < i_have.size();
+		for ( size_t groups = 0; groups <= SuitDistances::c_maxGroups; ++groups )
+		{
+			for ( size_t pair = 0; pair < 2; ++pair )
+			{
+				for ( size_t lastSeqs = 0; lastSeqs < c_countBase; ++lastSeqs )
+				{
+					for ( size_t prevSeqs = 0; prevSeqs < c_countBase; ++prevSeqs )
+					{
+						uint8_t const cost = costs[ groups ][ pair ][ lastSeqs ][ prevSeqs ];
+						if ( cost == c_unreachable )
+						{
+							continue;
+						}
+
+						for ( size_t triplet = 0; triplet < 2; ++triplet )
+						{
+							for ( size_t newPair = 0; newPair + pair < 2; ++newPair )
+							{
+								for ( size_t newSeqs = 0; newSeqs <= ( canStartSequence ? c_maxCopies : 0 ); ++newSeqs )
+								{
+									size_t const newGroups = groups + triplet + newSeqs;
+									size_t const required = 3 * triplet + 2 * newPair + newSeqs + lastSeqs + prevSeqs;
+									if ( newGroups > SuitDistances::c_maxGroups || required > c_maxCopies )
+									{
+										continue;
+									}
+
+									uint8_t const missing = required > i_have[ faceI ] ? static_cast< uint8_t >( required - i_have[ faceI ] ) : 0;
+									uint8_t& nextCost = next[ newGroups ][ pair + newPair ][ newSeqs ][ lastSeqs ];
+									nextCost = std::min( nextCost, static_cast< uint8_t >( cost + missing ) );
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+		costs = next;
+	}
+
+	SuitDistances distances;
+	for ( size_t groups = 0; groups <= SuitDistances::c_maxGroups; ++groups )
+	{
+		for ( size_t pair = 0; pair < 2; ++pair )
+		{
+			riEnsure( costs[ groups ][ pair ][ 0 ][ 0 ] != c_unreachable, "Every group count should be reachable in a suit" );
+			distances.m_tilesNeeded[ groups ][ pair ] = costs[ groups ][ pair ][ 0 ][ 0 ];
+		}
+	}
+	return distances;
+}
+
+//------------------------------------------------------------------------------
+static SuitDistances LookupDistances
+(
+	std::atomic<uint64_t>* io_table,
+	Span<uint8_t const> i_have,
+	bool i_allowSequences
+)
+{
+	size_t pattern = 0;
+	for ( uint8_t count : i_have )
+	{
+		pattern = pattern * c_countBase + std::min<size_t>( count, c_maxCopies );
+	}
+
+	uint64_t packed = io_table[ pattern ].load( std::memory_order_relaxed );
+	if ( ( packed & c_filledBit ) == 0 )
+	{
+		// Racing threads will all calculate the same value, so there's no harm in more than one storing it
+		SuitDistances const distances = CalculateDistances( i_have, i_allowSequences );
+		packed = c_filledBit;
+		for ( size_t groups = 0; groups <= SuitDistances::c_maxGroups; ++groups )
+		{
+			for ( size_t pair = 0; pair < 2; ++pair )
+			{
+				packed |= uint64_t{ distances.m_tilesNeeded[ groups ][ pair ] } << ( ( groups * 2 + pair ) * c_entryBits );
+			}
+		}
+		io_table[ pattern ].store( packed, std::memory_order_relaxed );
+		return distances;
+	}
+
+	SuitDistances distances;
+	for ( size_t groups = 0; groups <= SuitDistances::c_maxGroups; ++groups )
+	{
+		for ( size_t pair = 0; pair < 2; ++pair )
+		{
+			distances.m_tilesNeeded[ groups ][ pair ] = static_cast< uint8_t >( ( packed >> ( ( groups * 2 + pair ) * c_entryBits ) ) & c_entryMask );
+		}
+	}
+	return distances;
+}
+
+//------------------------------------------------------------------------------
+SuitDistances NumberSuitDistances
+(
+	TileCounts const& i_counts,
+	Suit i_suit
+)
+{
+	Array<uint8_t, Numbers::Count()> have;
+	for ( size_t faceI = 0; faceI < have.size(); ++faceI )
+	{
+		have[ faceI ] = i_counts[ TileKind{ i_suit, Numbers::IndexToValue( faceI ) } ];
+	}
+	return LookupDistances( s_numberSuitTable, have, true );
+}
+
+//------------------------------------------------------------------------------
+SuitDistances HonourDistances
+(
+	TileCounts const& i_counts
+)
+{
+	Array<uint8_t, Honours::Count()> have;
+	for ( size_t faceI = 0; faceI < have.size(); ++faceI )
+	{
+		have[ faceI ] = i_counts[ TileKind{ Honours::IndexToValue( faceI ) } ];
+	}
+	return LookupDistances( s_honourTable, have, false );
+}
+
+}
+
+namespace Riichi
+{
+
+// The three suits then the honours, matching the order kinds are indexed in
+using CategoryDistances = Array<Detail::SuitDistances, Suits::Count() + 1>;
+static constexpr size_t c_honourCategory = Suits::Count();
+
+//------------------------------------------------------------------------------
+static size_t Category
+(
+	TileKindIndex i_kind
+)
+{
+	return std::min<size_t>( i_kind / Numbers::Count(), c_honourCategory );
+}
+
+//------------------------------------------------------------------------------
+static Detail::SuitDistances CategoryDistancesFor
+(
+	TileCounts const& i_counts,
+	size_t i_category
+)
+{
+	return i_category == c_honourCategory
+		? Detail::HonourDistances( i_counts )
+		: Detail::NumberSuitDistances( i_counts, Suits::IndexToValue( i_category ) );
+}
+
+//------------------------------------------------------------------------------
+// Combined distances before any category is added, where only needing no groups and no pair is reachable
+//------------------------------------------------------------------------------
+static constexpr uint8_t c_unreachable = std::numeric_limits<uint8_t>::max();
+
+static Detail::SuitDistances NothingCombined
+(
+)
+{
+	Detail::SuitDistances combined;
+	for ( auto& byPair : combined.m_tilesNeeded ) byPair.fill( c_unreachable );
+	combined.m_tilesNeeded[ 0 ][ 0 ] = 0;
+	return combined;
+}
+
+//------------------------------------------------------------------------------
+static Detail::SuitDistances MergeCategory
+(
+	Detail::SuitDistances const& i_combined,
+	Detail::SuitDistances const& i_category
+)
+{
+	using Detail::SuitDistances;
+
+	// Spread the groups still needed and the pair between what's combined so far and the new category
+	SuitDistances next;
+	for ( auto& byPair : next.m_tilesNeeded ) byPair.fill( c_unreachable );
+
+	for ( size_t groups = 0; groups <= SuitDistances::c_maxGroups; ++groups )
+	{
+		for ( size_t pair = 0; pair < 2; ++pair )
+		{
+			uint8_t const soFar = i_combined.m_tilesNeeded[ groups ][ pair ];
+			if ( soFar == c_unreachable )
+			{
+				continue;
+			}
+			for ( size_t addGroups = 0; groups + addGroups <= SuitDistances::c_maxGroups; ++addGroups )
+			{
+				for ( size_t addPair = 0; pair + addPair < 2; ++addPair )
+				{
+					uint8_t& nextCost = next.m_tilesNeeded[ groups + addGroups ][ pair + addPair ];
+					nextCost = std::min( nextCost, static_cast< uint8_t >( soFar + i_category.m_tilesNeeded[ addGroups ][ addPair ] ) );
+				}
+			}
+		}
+	}
+	return next;
+}
+
+//------------------------------------------------------------------------------
+// Same as merging the last category and reading off the shanten, but only works out the one entry that's needed
+//------------------------------------------------------------------------------
+static int CombineLastCategory
+(
+	Detail::SuitDistances const& i_others,
+	Detail::SuitDistances const& i_last,
+	size_t i_meldCount
+)
+{
+	using Detail::SuitDistances;
+	if ( i_meldCount > SuitDistances::c_maxGroups )
+	{
+		return c_impossibleShanten;
+	}
+
+	size_t const groupsNeeded = SuitDistances::c_maxGroups - i_meldCount;
+	int tilesNeeded = std::numeric_limits<int>::max();
+	for ( size_t lastGroups = 0; lastGroups <= groupsNeeded; ++lastGroups )
+	{
+		for ( size_t lastPair = 0; lastPair < 2; ++lastPair )
+		{
+			uint8_t const others = i_others.m_tilesNeeded[ groupsNeeded - lastGroups ][ 1 - lastPair ];
+			if ( others != c_unreachable )
+			{
+				tilesNeeded = std::min( tilesNeeded, others + i_last.m_tilesNeeded[ lastGroups ][ lastPair ] );
+			}
+		}
+	}
+
+	// Needing one more tile is tenpai
+	return tilesNeeded - 1;
+}
+
+//------------------------------------------------------------------------------
+static int CombineCategories
+(
+	CategoryDistances const& i_categories,
+	size_t i_meldCount
+)
+{
+	Detail::SuitDistances combined = NothingCombined();
+	for ( size_t categoryI = 0; categoryI + 1 < i_categories.size(); ++categoryI )
+	{
+		combined = MergeCategory( combined, i_categories[ categoryI ] );
+	}
+	return CombineLastCategory( combined, i_categories.back(), i_meldCount );
+}
+
+//------------------------------------------------------------------------------
+// Every category but one merged together, ready for CombineLastCategory
+//------------------------------------------------------------------------------
+static Detail::SuitDistances CombineOtherCategories
+(
+	CategoryDistances const& i_categories,
+	size_t i_except
+)
+{
+	Detail::SuitDistances combined = NothingCombined();
+	for ( size_t categoryI = 0; categoryI < i_categories.size(); ++categoryI )
+	{
+		if ( categoryI != i_except )
+		{
+			combined = MergeCategory( combined, i_categories[ categoryI ] );
+		}
+	}
+	return combined;
+}
+
+//------------------------------------------------------------------------------
+static int StandardShanten
+(
+	TileCounts const& i_freeTiles,
+	size_t i_meldCount
+)
+{
+	if ( i_meldCount > Detail::SuitDistances::c_maxGroups )
+	{
+		return c_impossibleShanten;
+	}
+
+	CategoryDistances categories;
+	for ( size_t categoryI = 0; categoryI < categories.size(); ++categoryI )
+	{
+		categories[ categoryI ] = CategoryDistancesFor( i_freeTiles, categoryI );
+	}
+	return CombineCategories( categories, i_meldCount );
+}
+
+//------------------------------------------------------------------------------
+static int SevenPairsShanten
+(
+	TileCounts const& i_freeTiles,
+	size_t i_meldCount
+)
+{
+	if ( i_meldCount > 0 )
+	{
+		return c_impossibleShanten;
+	}
+
+	int pairs = 0;
+	int kinds = 0;
+	i_freeTiles.ForEachKind(
+		[ & ]( TileKind, uint8_t i_count )
+		{
+			++kinds;
+			pairs += i_count >= 2 ? 1 : 0;
+		}
+	);
+
+	// Pairs must all be different kinds, so being short on kinds costs extra draws
+	return 6 - pairs + std::max( 0, 7 - kinds );
+}
+
+//------------------------------------------------------------------------------
+static int ThirteenOrphansShanten
+(
+	TileCounts const& i_freeTiles,
+	size_t i_meldCount
+)
+{
+	if ( i_meldCount > 0 )
+	{
+		return c_impossibleShanten;
+	}
+
+	int orphanKinds = 0;
+	bool orphanPair = false;
+	i_freeTiles.ForEachKind(
+		[ & ]( TileKind i_kind, uint8_t i_count )
+		{
+			if ( i_kind.IsHonourOrTerminal() )
+			{
+				++orphanKinds;
+				orphanPair |= i_count >= 2;
+			}
+		}
+	);
+
+	return 13 - orphanKinds - ( orphanPair ? 1 : 0 );
+}
+
+//------------------------------------------------------------------------------
+int Shanten
+(
+	Hand const& i_hand
+)
+{
+	return Shanten( i_hand.FreeTileCounts(), i_hand.Melds().size() );
+}
+
+//------------------------------------------------------------------------------
+int Shanten
+(
+	TileCounts const& i_freeTiles,
+	size_t i_meldCount
+)
+{
+	return std::min( {
+		StandardShanten( i_freeTiles, i_meldCount ),
+		SevenPairsShanten( i_freeTiles, i_meldCount ),
+		ThirteenOrphansShanten( i_freeTiles, i_meldCount ),
+	} );
+}
+
+//------------------------------------------------------------------------------
+int Shanten
+(
+	TileCounts const& i_freeTiles,
+	size_t i_meldCount,
+	ShantenForm i_form
+)
+{
+	switch ( i_form )
+	{
+	case ShantenForm::Standard: return StandardShanten( i_freeTiles, i_meldCount );
+	case ShantenForm::SevenPairs: return SevenPairsShanten( i_freeTiles, i_meldCount );
+	case ShantenForm::ThirteenOrphans: return ThirteenOrphansShanten( i_freeTiles, i_meldCount );
+	}
+
+	riError( "Unknown shanten form" );
+	return c_impossibleShanten;
+}
+
+//------------------------------------------------------------------------------
+// Standard distances for a hand holding a drawn tile, shared between all of its discards and the draws after them.
+// A discard or a draw only changes the distances of its own category, so the rest are worked out once.
+// Drawing into a category the discard didn't touch is the same for every discard, so those are worked out up front too.
+//------------------------------------------------------------------------------
+struct SharedDiscardDistances
+{
+	static constexpr uint64_t c_allKinds = ( uint64_t{ 1 } << TileKindIndex::c_count ) - 1;
+
+	TileCounts const& m_freeTiles;
+	size_t m_meldCount;
+	uint64_t m_drawKinds; // Mask of TileKindIndex bits, the only draws worth visiting
+	CategoryDistances m_handCategories;
+	CategoryDistances m_handOtherCategories; // For each category, every other one merged
+	Array<Detail::SuitDistances, TileKindIndex::c_count> m_drawnIntoHand;
+
+	SharedDiscardDistances( TileCounts const& i_freeTiles, size_t i_meldCount, uint64_t i_drawKinds )
+		: m_freeTiles{ i_freeTiles }
+		, m_meldCount{ i_meldCount }
+		, m_drawKinds{ i_drawKinds }
+	{
+		riEnsure( m_freeTiles.Total() % 3 == 2, "Discards need a hand holding a drawn tile" );
+
+		for ( size_t categoryI = 0; categoryI < m_handCategories.size(); ++categoryI )
+		{
+			m_handCategories[ categoryI ] = CategoryDistancesFor( m_freeTiles, categoryI );
+		}
+		for ( size_t categoryI = 0; categoryI < m_handCategories.size(); ++categoryI )
+		{
+			m_handOtherCategories[ categoryI ] = CombineOtherCategories( m_handCategories, categoryI );
+		}
+
+		for ( size_t kindI = 0; kindI < TileKindIndex::c_count; ++kindI )
+		{
+			TileKindIndex const kind{ kindI };
+			if ( ( m_drawKinds >> kindI & 1u ) != 0 && m_freeTiles[ kind ] < Detail::c_maxCopies )
+			{
+				TileCounts withDraw = m_freeTiles;
+				withDraw.Add( kind.Kind() );
+				m_drawnIntoHand[ kind ] = CategoryDistancesFor( withDraw, Category( kind ) );
+			}
+		}
+	}
+
+	int Shanten( int i_standardShanten, TileCounts const& i_counts ) const
+	{
+		return std::min( {
+			i_standardShanten,
+			SevenPairsShanten( i_counts, m_meldCount ),
+			ThirteenOrphansShanten( i_counts, m_meldCount ),
+		} );
+	}
+
+	// The hand once a discard has gone
+	struct AfterDiscard
+	{
+		TileKindIndex m_discard;
+		TileCounts m_counts;
+		CategoryDistances m_categories;
+		int m_standardShanten;
+	};
+
+	AfterDiscard Discard( TileKindIndex i_discard ) const
+	{
+		AfterDiscard after{ i_discard, m_freeTiles, m_handCategories };
+		after.m_counts.Remove( i_discard.Kind() );
+		size_t const discardCategory = Category( i_discard );
+		after.m_categories[ discardCategory ] = CategoryDistancesFor( after.m_counts, discardCategory );
+		after.m_standardShanten = CombineLastCategory( m_handOtherCategories[ discardCategory ], after.m_categories[ discardCategory ], m_meldCount );
+		return after;
+	}
+
+	// Calls i_fnVisit( draw, standard shanten, counts ) for every kind worth visiting that could still be drawn once the discard has gone
+	template<typename T_Visitor>
+	void ForEachDraw( AfterDiscard const& i_afterDiscard, T_Visitor&& i_fnVisit ) const
+	{
+		// Merging everything but the draw's category leaves a single entry to work out per draw
+		size_t const discardCategory = Category( i_afterDiscard.m_discard );
+		CategoryDistances otherCategories;
+		for ( size_t categoryI = 0; categoryI < otherCategories.size(); ++categoryI )
+		{
+			otherCategories[ categoryI ] = categoryI == discardCategory
+				? m_handOtherCategories[ categoryI ]
+				: CombineOtherCategories( i_afterDiscard.m_categories, categoryI );
+		}
+
+		for ( size_t drawI = 0; drawI < TileKindIndex::c_count; ++drawI )
+		{
+			TileKindIndex const draw{ drawI };
+			if ( ( m_drawKinds >> drawI & 1u ) == 0 || i_afterDiscard.m_counts[ draw ] >= Detail::c_maxCopies )
+			{
+				continue;
+			}
+
+			TileCounts afterDraw = i_afterDiscard.m_counts;
+			afterDraw.Add( draw.Kind() );
+			size_t const drawCategory = Category( draw );
+			Detail::SuitDistances const drawDistances = drawCategory == discardCategory
+				? CategoryDistancesFor( afterDraw, drawCategory )
+				: m_drawnIntoHand[ draw ];
+
+			i_fnVisit( draw, CombineLastCategory( otherCategories[ drawCategory ], drawDistances, m_meldCount ), afterDraw );
+		}
+	}
+};
+
+//------------------------------------------------------------------------------
+Vector<DiscardOption> RankDiscards
+(
+	TileCounts const& i_freeTiles,
+	size_t i_meldCount,
+	TileCounts const& i_visibleTiles
+)
+{
+	// Any kind might help, if only as another orphan
+	SharedDiscardDistances const shared( i_freeTiles, i_meldCount, SharedDiscardDistances::c_allKinds );
+	TileCounts const unseenTiles = i_visibleTiles.Remaining( Detail::c_maxCopies );
+
+	Vector<DiscardOption> options;
+	for ( size_t discardI = 0; discardI < TileKindIndex::c_count; ++discardI )
+	{
+		TileKindIndex const discard{ discardI };
+		if ( i_freeTiles[ discard ] == 0 )
+		{
+			continue;
+		}
+
+		SharedDiscardDistances::AfterDiscard const afterDiscard = shared.Discard( discard );
+		DiscardOption& option = options.emplace_back( discard, shared.Shanten( afterDiscard.m_standardShanten, afterDiscard.m_counts ) );
+		shared.ForEachDraw( afterDiscard, [ & ]( TileKindIndex i_draw, int i_standardShanten, TileCounts const& i_afterDraw )
+		{
+			if ( shared.Shanten( i_standardShanten, i_afterDraw ) < option.m_shanten )
+			{
+				option.m_accepted.Insert( i_draw );
+				if ( unseenTiles[ i_draw ] > 0 )
+				{
+					option.m_acceptedLive.Add( i_draw.Kind(), unseenTiles[ i_draw ] );
+				}
+			}
+		} );
+	}
+
+	std::ranges::sort( options, []( DiscardOption const& i_a, DiscardOption const& i_b )
+	{
+		if ( i_a.m_shanten != i_b.m_shanten ) { return i_a.m_shanten < i_b.m_shanten; }
+		if ( i_a.AcceptedLiveTotal() != i_b.AcceptedLiveTotal() ) { return i_a.AcceptedLiveTotal() > i_b.AcceptedLiveTotal(); }
+		return i_a.m_discard < i_b.m_discard;
+	} );
+	return options;
+}
+
+//------------------------------------------------------------------------------
+Array<TileKindSet, TileKindIndex::c_count> WaitsAfterDiscards
+(
+	TileCounts const& i_freeTiles,
+	size_t i_meldCount
+)
+{
+	// A draw can only complete a group or pair with a tile already held, so it must be a held honour or a number within two of one in its suit
+	uint64_t const heldKinds = i_freeTiles.KindMask();
+	uint64_t drawKinds = 0;
+	for ( size_t kindI = 0; kindI < TileKindIndex::c_count; ++kindI )
+	{
+		if ( ( heldKinds >> kindI & 1u ) == 0 )
+		{
+			continue;
+		}
+		if ( Category( TileKindIndex{ kindI } ) == c_honourCategory )
+		{
+			drawKinds |= uint64_t{ 1 } << kindI;
+			continue;
+		}
+		size_t const suitStart = kindI - kindI % Numbers::Count();
+		for ( size_t nearI = std::max( kindI, suitStart + 2 ) - 2; nearI <= std::min( kindI + 2, suitStart + Numbers::Count() - 1 ); ++nearI )
+		{
+			drawKinds |= uint64_t{ 1 } << nearI;
+		}
+	}
+	SharedDiscardDistances const shared( i_freeTiles, i_meldCount, drawKinds );
+
+	Array<TileKindSet, TileKindIndex::c_count> waits;
+	for ( size_t discardI = 0; discardI < TileKindIndex::c_count; ++discardI )
+	{
+		TileKindIndex const discard{ discardI };
+		if ( i_freeTiles[ discard ] == 0 )
+		{
+			continue;
+		}
+
+		SharedDiscardDistances::AfterDiscard const afterDiscard = shared.Discard( discard );
+		if ( afterDiscard.m_standardShanten != 0 )
+		{
+			continue;
+		}
+
+		shared.ForEachDraw( afterDiscard, [ & ]( TileKindIndex i_draw, int i_standardShanten, TileCounts const& )
+		{
+			if ( i_standardShanten < 0 )
+			{
+				waits[ discard ].Insert( i_draw );
+			}
+		} );
+	}
+	return waits;
+}
+
+//------------------------------------------------------------------------------
+Vector<DiscardOption> RankDiscards
+(
+	Hand const& i_hand,
+	Option<TileInstance> const& i_drawnTile,
+	TileCounts const& i_visibleTiles
+)
+{
+	TileCounts freeTiles = i_hand.FreeTileCounts();
+	if ( i_drawnTile.has_value() )
+	{
+		freeTiles.Add( i_drawnTile->Tile() );
+	}
+	return RankDiscards( freeTiles, i_hand.Melds().size(), i_visibleTiles );
+}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Containers.hpp"
+#include "Declare.hpp"
+#include "Tile.hpp"
+#include "TileCounts.hpp"
+#include "TileKindSet.hpp"
+
+namespace Riichi
+{
+
+//------------------------------------------------------------------------------
+// Shanten is the number of tiles a hand needs to draw before it is tenpai.
+// 0 means tenpai, and -1 means the hand is already complete (only possible with
+// a drawn tile included in the counts).
+//
+// These work purely on tile counts, so they can be asked of a 13 tile hand or
+// a 14 tile hand with the draw included. Melds are taken as already complete.
+//------------------------------------------------------------------------------
+enum class ShantenForm : EnumValueType
+{
+	Standard,			// 4 groups and a pair
+	SevenPairs,
+	ThirteenOrphans,
+};
+
+// Reported for forms that can't be made with the hand, e.g. seven pairs once there are melds
+constexpr int c_impossibleShanten = 99;
+
+// Smallest shanten across every form that's possible with the given meld count
+int Shanten( Hand const& i_hand );
+int Shanten( TileCounts const& i_freeTiles, size_t i_meldCount );
+
+// Shanten for a specific form
+int Shanten( TileCounts const& i_freeTiles, size_t i_meldCount, ShantenForm i_form );
+
+//------------------------------------------------------------------------------
+// How a hand holding a drawn tile (3n+2 free tiles) is left by discarding one kind.
+// Accepted kinds are the draws that would then lower shanten, i.e. the ukeire.
+//------------------------------------------------------------------------------
+struct DiscardOption
+{
+	TileKindIndex m_discard;
+	int m_shanten;
+	TileKindSet m_accepted;
+	TileCounts m_acceptedLive; // Copies of each accepted kind that haven't been seen yet
+
+	size_t AcceptedLiveTotal() const { return m_acceptedLive.Total(); }
+};
+
+// One option per distinct kind held, best first: lowest shanten, then the most live accepted tiles.
+// i_visibleTiles should count every tile the player can see, including those in their own hand.
+// All the discards share one pass over the hand's counts, rather than being assessed one by one.
+Vector<DiscardOption> RankDiscards( TileCounts const& i_freeTiles, size_t i_meldCount, TileCounts const& i_visibleTiles );
+Vector<DiscardOption> RankDiscards( Hand const& i_hand, Option<TileInstance> const& i_drawnTile, TileCounts const& i_visibleTiles );
+
+// For each kind a hand holding a drawn tile could discard, the draws that would then complete it as groups and a pair, i.e. the standard waits it leaves.
+// Shares the same pass as RankDiscards. Kinds not held, and discards that don't leave the hand tenpai, have no waits.
+// A wait on a fifth copy of a kind can't be seen, so these are only the full waits when no kind is held four times.
+Array<TileKindSet, TileKindIndex::c_count> WaitsAfterDiscards( TileCounts const& i_freeTiles, size_t i_meldCount );
+
+//------------------------------------------------------------------------------
+namespace Detail
+{
+
+//------------------------------------------------------------------------------
+// The per-suit building block of standard shanten.
+// For a single suit (or the honours), how many more tiles are needed so that it
+// holds exactly the given number of groups, and optionally the pair.
+// Each suit pattern is computed once, then served from a lock-free table.
+//------------------------------------------------------------------------------
+struct SuitDistances
+{
+	static constexpr size_t c_maxGroups = 4;
+
+	Array<Array<uint8_t, 2>, c_maxGroups + 1> m_tilesNeeded{}; // [ groups ][ has pair ]
+};
+
+SuitDistances NumberSuitDistances( TileCounts const& i_counts, Suit i_suit );
+SuitDistances HonourDistances( TileCounts const& i_counts );
+
+}
+
+}
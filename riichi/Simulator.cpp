@@ -0,0 +1,292 @@
+#include "Simulator.hpp"
+
+#include "Random.hpp"
+#include "Round.hpp"
+#include "Rules.hpp"
+#include "Table.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+namespace Riichi
+{
+
+//------------------------------------------------------------------------------
+static void MixIntoDigest
+(
+	uint64_t& io_digest,
+	uint64_t i_value
+)
+{
+	io_digest = SplitMix64Finalise( io_digest ^ ( i_value + 0x9e3779b97f4a7c15ull ) );
+}
+
+//------------------------------------------------------------------------------
+void SimulationSummary::Add
+(
+	GameResult const& i_result
+)
+{
+	++m_games;
+	m_rounds += i_result.m_rounds;
+	m_tsumos += i_result.m_tsumos;
+	m_rons += i_result.m_rons;
+	m_exhaustiveDraws += i_result.m_exhaustiveDraws;
+	m_transitions += i_result.m_transitions;
+
+	MixIntoDigest( m_digest, i_result.m_tableIndex );
+	MixIntoDigest( m_digest, i_result.m_rounds );
+	MixIntoDigest( m_digest, i_result.m_transitions );
+
+	if ( m_players.size() < i_result.m_players.size() )
+	{
+		m_players.resize( i_result.m_players.size() );
+	}
+	for ( size_t playerI = 0; playerI < i_result.m_players.size(); ++playerI )
+	{
+		SimulatedPlayerResult const& player = i_result.m_players[ playerI ];
+		PlayerTotals& totals = m_players[ playerI ];
+		totals.m_totalPoints += player.m_finalPoints;
+		++totals.m_placements[ std::min( player.m_placement, totals.m_placements.size() - 1 ) ];
+		totals.m_wins += player.m_wins;
+		totals.m_dealIns += player.m_dealIns;
+		totals.m_riichis += player.m_riichis;
+
+		MixIntoDigest( m_digest, static_cast< uint64_t >( player.m_finalPoints ) );
+		MixIntoDigest( m_digest, player.m_wins );
+		MixIntoDigest( m_digest, player.m_dealIns );
+	}
+}
+
+//------------------------------------------------------------------------------
+std::ostream& SimulationSummary::Print
+(
+	std::ostream& io_out
+)	const
+{
+	io_out << "Games: " << m_games << "\tRounds: " << m_rounds << "\tTransitions: " << m_transitions << '\n';
+	io_out << "Tsumo: " << m_tsumos << "\tRon: " << m_rons << "\tExhaustive draws: " << m_exhaustiveDraws << '\n';
+	for ( size_t playerI = 0; playerI < m_players.size(); ++playerI )
+	{
+		PlayerTotals const& totals = m_players[ playerI ];
+		io_out << "Player " << playerI << ":\tAverage points: " << ( m_games > 0 ? totals.m_totalPoints / static_cast< int64_t >( m_games ) : 0 )
+			<< "\tPlacements:";
+		for ( uint64_t placementCount : totals.m_placements )
+		{
+			io_out << ' ' << placementCount;
+		}
+		io_out << "\tWins: " << totals.m_wins << "\tDeal-ins: " << totals.m_dealIns << "\tRiichis: " << totals.m_riichis << '\n';
+	}
+
+	std::ios_base::fmtflags const flags = io_out.flags();
+	io_out << "Digest: " << std::hex << std::setfill( '0' ) << std::setw( 16 ) << m_digest;
+	io_out.flags( flags );
+	return io_out;
+}
+
+//------------------------------------------------------------------------------
+Simulator::Simulator
+(
+	Config i_config
+)
+	: m_config{ std::move( i_config ) }
+{
+	riEnsure( m_config.m_rules, "Simulator needs rules" );
+	riEnsure( m_config.m_makePlayers, "Simulator needs a way to make players" );
+}
+
+//------------------------------------------------------------------------------
+void Simulator::Run
+(
+	SimulationAggregator& io_aggregator
+)	const
+{
+	size_t const tableCount = m_config.m_tableCount;
+	size_t const threadCount = std::min(
+		m_config.m_threadCount > 0 ? m_config.m_threadCount : std::max( size_t{ std::thread::hardware_concurrency() }, size_t{ 1 } ),
+		std::max( tableCount, size_t{ 1 } )
+	);
+
+	// Workers finish tables out of order, so results wait here until every table before them is in.
+	// Workers are never let too far ahead of the aggregator, to bound how many can pile up.
+	size_t const window = threadCount * 4;
+
+	std::mutex mutex;
+	std::condition_variable resultReady;
+	std::condition_variable windowMoved;
+	Map<size_t, GameResult> pending;
+	size_t nextToClaim = 0;
+	size_t nextToAggregate = 0;
+
+	auto fnWorker = [ & ]()
+	{
+		while ( true )
+		{
+			size_t tableIndex = 0;
+			{
+				std::unique_lock lock( mutex );
+				windowMoved.wait( lock, [ & ] { return nextToClaim >= tableCount || nextToClaim < nextToAggregate + window; } );
+				if ( nextToClaim >= tableCount )
+				{
+					return;
+				}
+				tableIndex = nextToClaim++;
+			}
+
+			GameResult result = PlayTable( tableIndex );
+
+			{
+				std::scoped_lock lock( mutex );
+				pending.emplace( tableIndex, std::move( result ) );
+			}
+			resultReady.notify_one();
+		}
+	};
+
+	Vector<std::thread> workers;
+	workers.reserve( threadCount );
+	for ( size_t threadI = 0; threadI < threadCount; ++threadI )
+	{
+		workers.emplace_back( fnWorker );
+	}
+
+	{
+		std::unique_lock lock( mutex );
+		while ( nextToAggregate < tableCount )
+		{
+			resultReady.wait( lock, [ & ] { return pending.contains( nextToAggregate ); } );
+			GameResult const result = std::move( pending.extract( nextToAggregate ).mapped() );
+
+			lock.unlock();
+			io_aggregator.Add( result );
+			lock.lock();
+
+			++nextToAggregate;
+			windowMoved.notify_all();
+		}
+	}
+
+	for ( std::thread& worker : workers )
+	{
+		worker.join();
+	}
+}
+
+//------------------------------------------------------------------------------
+GameResult Simulator::PlayTable
+(
+	size_t i_tableIndex
+)	const
+{
+	GameResult result;
+	result.m_tableIndex = i_tableIndex;
+	result.m_seeds = TableSeeds( m_config.m_masterSeed, i_tableIndex );
+
+	Table table( m_config.m_rules, result.m_seeds.m_shuffleSeed, result.m_seeds.m_aiSeed );
+	if ( m_config.m_evaluationCacheCapacity > 0 )
+	{
+		table.EnableEvaluationCache( m_config.m_evaluationCacheCapacity );
+	}
+
+	Vector<PlayerID> playerIDs;
+	for ( Player& player : m_config.m_makePlayers( i_tableIndex ) )
+	{
+		riEnsure( player.Type() == PlayerType::AI, "Simulated players must all be AI" );
+		playerIDs.push_back( table.AddPlayer( std::move( player ) ) );
+	}
+	result.m_players.resize( playerIDs.size() );
+
+	auto fnPlayerAt = [ & ]( Seat i_seat ) -> SimulatedPlayerResult&
+	{
+		PlayerID const playerID = table.GetRound().GetPlayerID( i_seat );
+		return result.m_players[ static_cast< size_t >( std::ranges::find( playerIDs, playerID ) - playerIDs.begin() ) ];
+	};
+
+	// Driven through the same API as any other user of the table, just with nobody to ask
+	while ( true )
+	{
+		bool const startingRound = table.GetState().Type() == TableStateType::BetweenRounds;
+		if ( !table.AdvanceAIOnly() )
+		{
+			break;
+		}
+		if ( startingRound )
+		{
+			++result.m_rounds;
+		}
+		++result.m_transitions;
+
+		TableEvent const event = table.RetrieveEvent();
+		switch ( event.Type() )
+		{
+		using enum TableEventType;
+
+		case Riichi:
+		{
+			++fnPlayerAt( event.Get<Riichi>().Player() ).m_riichis;
+			break;
+		}
+		case Tsumo:
+		{
+			++result.m_tsumos;
+			++fnPlayerAt( event.Get<Tsumo>().Winner() ).m_wins;
+			break;
+		}
+		case Ron:
+		{
+			TableEvents::Ron const& ron = event.Get<Ron>();
+			++result.m_rons;
+			for ( Seat winner : ron.Winners() )
+			{
+				++fnPlayerAt( winner ).m_wins;
+			}
+			++fnPlayerAt( ron.Loser() ).m_dealIns;
+			break;
+		}
+		case WallDepleted:
+		{
+			++result.m_exhaustiveDraws;
+			break;
+		}
+		default:
+		{
+			break;
+		}
+		}
+	}
+
+	Vector<size_t> order( playerIDs.size() );
+	std::iota( order.begin(), order.end(), size_t{ 0 } );
+	for ( size_t playerI = 0; playerI < playerIDs.size(); ++playerI )
+	{
+		result.m_players[ playerI ].m_finalPoints = table.GetPoints( playerIDs[ playerI ] );
+	}
+	std::ranges::stable_sort( order, std::greater{}, [ & ]( size_t i_playerI ) { return result.m_players[ i_playerI ].m_finalPoints; } );
+	for ( size_t placement = 0; placement < order.size(); ++placement )
+	{
+		result.m_players[ order[ placement ] ].m_placement = placement;
+	}
+
+	return result;
+}
+
+//------------------------------------------------------------------------------
+/*static*/ SimulationSeeds Simulator::TableSeeds
+(
+	uint64_t i_masterSeed,
+	size_t i_tableIndex
+)
+{
+	uint64_t state = i_masterSeed + 2 * static_cast< uint64_t >( i_tableIndex ) * 0x9e3779b97f4a7c15ull;
+	SimulationSeeds seeds;
+	seeds.m_shuffleSeed = static_cast< unsigned int >( SplitMix64( state ) );
+	seeds.m_aiSeed = static_cast< unsigned int >( SplitMix64( state ) );
+	return seeds;
+}
+
+}
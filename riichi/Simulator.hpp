@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Containers.hpp"
+#include "Declare.hpp"
+#include "Player.hpp"
+
+#include <functional>
+#include <iosfwd>
+#include <memory>
+
+namespace Riichi
+{
+
+//------------------------------------------------------------------------------
+// Seeds for a single simulated table
+//------------------------------------------------------------------------------
+struct SimulationSeeds
+{
+	unsigned int m_shuffleSeed{ 0 };
+	unsigned int m_aiSeed{ 0 };
+
+	friend bool operator==( SimulationSeeds const&, SimulationSeeds const& ) = default;
+};
+
+//------------------------------------------------------------------------------
+// What happened in a single simulated game.
+// Players are in the order the simulation set them up in.
+//------------------------------------------------------------------------------
+struct SimulatedPlayerResult
+{
+	Points m_finalPoints{ 0 };
+	size_t m_placement{ 0 }; // 0 is first, with ties going to whoever was set up first
+	size_t m_wins{ 0 };
+	size_t m_dealIns{ 0 };
+	size_t m_riichis{ 0 };
+
+	friend bool operator==( SimulatedPlayerResult const&, SimulatedPlayerResult const& ) = default;
+};
+
+struct GameResult
+{
+	size_t m_tableIndex{ 0 };
+	SimulationSeeds m_seeds;
+	size_t m_rounds{ 0 };
+	size_t m_tsumos{ 0 };
+	size_t m_rons{ 0 };
+	size_t m_exhaustiveDraws{ 0 };
+	size_t m_transitions{ 0 };
+	Vector<SimulatedPlayerResult> m_players;
+
+	friend bool operator==( GameResult const&, GameResult const& ) = default;
+};
+
+//------------------------------------------------------------------------------
+// Receives results as games finish.
+// The simulator always hands results over one at a time in table order, from the thread that called Run(),
+// so aggregators need no locking and end up the same whatever the number of worker threads.
+//------------------------------------------------------------------------------
+struct SimulationAggregator
+{
+	virtual ~SimulationAggregator() = default;
+
+	virtual void Add( GameResult const& i_result ) = 0;
+};
+
+//------------------------------------------------------------------------------
+// Running totals over every game, plus a digest of the results in order for checking runs match bit for bit
+//------------------------------------------------------------------------------
+struct SimulationSummary
+	: SimulationAggregator
+{
+	struct PlayerTotals
+	{
+		int64_t m_totalPoints{ 0 };
+		Array<uint64_t, 4> m_placements{};
+		uint64_t m_wins{ 0 };
+		uint64_t m_dealIns{ 0 };
+		uint64_t m_riichis{ 0 };
+
+		friend bool operator==( PlayerTotals const&, PlayerTotals const& ) = default;
+	};
+
+	uint64_t m_games{ 0 };
+	uint64_t m_rounds{ 0 };
+	uint64_t m_tsumos{ 0 };
+	uint64_t m_rons{ 0 };
+	uint64_t m_exhaustiveDraws{ 0 };
+	uint64_t m_transitions{ 0 };
+	uint64_t m_digest{ 0 };
+	Vector<PlayerTotals> m_players;
+
+	void Add( GameResult const& i_result ) override;
+	std::ostream& Print( std::ostream& io_out ) const;
+
+	friend bool operator==( SimulationSummary const&, SimulationSummary const& ) = default;
+};
+
+//------------------------------------------------------------------------------
+// Plays many independent AI-only games across a pool of worker threads.
+// Each table gets its own seeds, derived from one master seed and the table's index,
+// so any game can be replayed on its own and results don't depend on the thread count.
+//------------------------------------------------------------------------------
+class Simulator
+{
+public:
+	struct Config
+	{
+		size_t m_tableCount{ 0 };
+		uint64_t m_masterSeed{ 0 };
+		size_t m_threadCount{ 0 }; // 0 uses every hardware thread
+		size_t m_evaluationCacheCapacity{ 0 }; // 0 leaves each table's evaluation cache off
+
+		// Shared by every table
+		std::shared_ptr<Rules const> m_rules;
+		// Called once per table, possibly from several threads at once.
+		// Every player must have an agent, as nobody is there to play as a user.
+		std::function<Vector<Player>( size_t i_tableIndex )> m_makePlayers;
+	};
+
+	explicit Simulator( Config i_config );
+
+	// Plays every table, handing results to the aggregator in table order
+	void Run( SimulationAggregator& io_aggregator ) const;
+
+	// Plays just the one table, exactly as Run() would
+	GameResult PlayTable( size_t i_tableIndex ) const;
+
+	// The 2n-th and 2n+1-th outputs of a SplitMix64 stream starting from the master seed
+	static SimulationSeeds TableSeeds( uint64_t i_masterSeed, size_t i_tableIndex );
+
+private:
+	Config m_config;
+};
+
+}
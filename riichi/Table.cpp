@@ -11,7 +11,7 @@ namespace Riichi
 //------------------------------------------------------------------------------
 Table::Table
 (
-	std::unique_ptr<Rules>&& i_rules,
+	std::shared_ptr<Rules const> i_rules,
 	unsigned int i_shuffleSeed,
 	unsigned int i_aiSeed
 )
@@ -21,6 +21,64 @@ Table::Table
 	, m_aiRNG{ i_aiSeed }
 {}
 
+//------------------------------------------------------------------------------
+Table::Table
+(
+	Table const& i_table,
+	Vector<Player>&& i_players,
+	ForkTag
+)
+	: m_ident{ i_table.m_ident }
+	, m_rules{ i_table.m_rules }
+	, m_playerIDs{ i_table.m_playerIDs }
+	, m_rounds{ i_table.m_rounds }
+	, m_state{ i_table.m_state }
+	, m_mostRecentEvent{ i_table.m_mostRecentEvent }
+	, m_shuffleRNG{ i_table.m_shuffleRNG }
+	, m_aiRNG{ i_table.m_aiRNG }
+	, m_aiTokens{ i_table.m_aiTokens }
+{
+	riEnsure( i_players.size() == i_table.m_players.size(), "Need a clone of every player to fork" );
+	m_players.reserve( i_players.size() );
+	for ( size_t playerI = 0; playerI < i_players.size(); ++playerI )
+	{
+		m_players.push_back( { std::move( i_players[ playerI ] ), i_table.m_players[ playerI ].second } );
+	}
+
+	m_state.Visit( [ this ]( auto& io_state ) { static_cast< TableStates::Base& >( io_state ).Rebind( *this ); } );
+
+	// The round in play gets its own copy, which still points at the other table's cache, so it gets its own or none at all
+	if ( !m_rounds.empty() )
+	{
+		m_rounds.back() = std::make_shared<Round>( *m_rounds.back() );
+		m_rounds.back()->UseEvaluationCache( nullptr );
+	}
+	if ( i_table.m_evaluationCache )
+	{
+		EnableEvaluationCache( i_table.m_evaluationCache->Capacity() );
+	}
+}
+
+//------------------------------------------------------------------------------
+std::unique_ptr<Table> Table::Fork
+(
+)	const
+{
+	Vector<Player> players;
+	players.reserve( m_players.size() );
+	for ( auto const& [ player, points ] : m_players )
+	{
+		Option<Player> clone = player.Clone();
+		if ( !clone )
+		{
+			return nullptr;
+		}
+		players.push_back( std::move( clone.value() ) );
+	}
+
+	return std::unique_ptr<Table>( new Table( *this, std::move( players ), ForkTag{} ) );
+}
+
 //------------------------------------------------------------------------------
 PlayerID Table::AddPlayer
 (
@@ -103,6 +161,47 @@ std::ostream& Table::PrintStandings
 	return io_out;
 }
 
+//------------------------------------------------------------------------------
+bool Table::AdvanceAIOnly
+(
+)
+{
+	TableState const& state = m_state;
+	switch ( state.Type() )
+	{
+	using enum TableStateType;
+
+	case Setup: state.Get<Setup>().StartGame(); return true;
+	case BetweenRounds: state.Get<BetweenRounds>().StartRound(); return true;
+	case Turn_AI: state.Get<Turn_AI>().MakeDecision(); return true;
+	case BetweenTurns: state.Get<BetweenTurns>().UserPass(); return true;
+	case BetweenTurns_PendingAI: state.Get<BetweenTurns_PendingAI>().AdvanceDecisionCalculations(); return true;
+	case RonAKanChance: state.Get<RonAKanChance>().Pass(); return true;
+	case GameOver: return false;
+	case Turn_User:
+	{
+		riError( "AI-only tables should never have a user turn" );
+		return false;
+	}
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------------
+void Table::EnableEvaluationCache
+(
+	size_t i_capacity
+)
+{
+	m_evaluationCache = std::make_unique<HandEvaluationCache>( i_capacity );
+
+	// Finished rounds have had their cache taken away, as they no longer change hands
+	if ( !m_rounds.empty() )
+	{
+		m_rounds.back()->UseEvaluationCache( m_evaluationCache.get() );
+	}
+}
+
 //------------------------------------------------------------------------------
 void Table::Transition
 (
@@ -114,6 +213,24 @@ void Table::Transition
 	m_mostRecentEvent = std::move( i_nextEvent );
 }
 
+//------------------------------------------------------------------------------
+Pair<TileKindSet, Vector<TileInstance>> Table::WaitsWithYaku
+(
+	Round const& i_round,
+	Seat i_playerSeat,
+	TileDraw const& i_lastTile,
+	bool i_considerForRiichi
+)
+{
+	Hand const& hand = i_round.CurrentHand( i_playerSeat );
+	HandAssessment const& assessment = i_round.CurrentHandAssessment( i_playerSeat );
+	if ( m_evaluationCache )
+	{
+		return m_evaluationCache->WaitsWithYaku( *m_rules, i_round, i_playerSeat, hand, assessment, i_lastTile, i_considerForRiichi );
+	}
+	return m_rules->WaitsWithYaku( i_round, i_playerSeat, hand, assessment, i_lastTile, i_considerForRiichi );
+}
+
 //------------------------------------------------------------------------------
 bool Table::Playing
 (
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Containers.hpp"
+#include "HandEvaluationCache.hpp"
 #include "Player.hpp"
 #include "Random.hpp"
 #include "Round.hpp"
@@ -33,35 +34,47 @@ class Table
 private:
 	TableIdent m_ident{ 0 }; // TODO-DEBT: come up with some way to generate idents
 
-	std::unique_ptr<Rules> m_rules;
+	std::shared_ptr<Rules const> m_rules;
 	Vector<PlayerID> m_playerIDs;
 	Vector<Pair<Player, Points>> m_players;
-	Vector<Round> m_rounds;
+	Vector<std::shared_ptr<Round>> m_rounds; // Finished rounds never change again, so forks share them. Only the last is ever modified
 	TableState m_state;
 	TableEvent m_mostRecentEvent;
 	ShuffleRNG m_shuffleRNG;
 	AIRNG m_aiRNG;
 	TypeSafeIDGenerator<AI::DecisionToken> m_aiTokens;
+	std::unique_ptr<HandEvaluationCache> m_evaluationCache;
 
 public:
+	// Rules are only ever used through const, so one instance can be shared by any number of tables, on any threads
 	Table
 	(
-		std::unique_ptr<Rules>&& i_rules,
+		std::shared_ptr<Rules const> i_rules,
 		unsigned int i_shuffleSeed, // rng seed for tile shuffling
 		unsigned int i_aiSeed // rng seed for AI behaviour
 	);
 
 	// TODO-DEBT: disallow copies + moves because tablestates hold a direct reference to the table
-	// It would be really nice to fix this
+	// It would be really nice to fix this. Until then, Fork() makes copies that are rebound properly.
 	Table( Table const& ) = delete;
 	Table( Table&& ) = delete;
 	Table& operator=( Table const& ) = delete;
 	Table& operator=( Table&& ) = delete;
 
+	// An independent copy of the game as it stands, for searching ahead from the live position.
+	// Rules are shared, while players' agents are cloned and random engines carry on from the same state,
+	// so the fork plays out exactly as this table would if given the same decisions.
+	// Only the round in play is copied; earlier rounds are shared with this table, as nothing changes them any more.
+	// An evaluation cache, if enabled, starts empty with the same capacity.
+	// Returns null if any player's agent can't be cloned.
+	std::unique_ptr<Table> Fork() const;
+
 	// Setup
 	PlayerID AddPlayer( Player&& i_player );
 	
 	// General data access
+	Rules const& GetRules() const { return *m_rules; }
+	std::shared_ptr<Rules const> const& SharedRules() const { return m_rules; }
 	Player const& GetPlayer( PlayerID i_playerID ) const;
 	inline auto AllPlayers() const;
 	Points GetPoints( PlayerID i_playerID ) const;
@@ -72,19 +85,33 @@ public:
 	bool Playing() const;
 	TableState const& GetState() const { return m_state; }
 	bool HasRounds() const { return !m_rounds.empty(); }
-	Round const& GetRound( size_t i_roundIndex = SIZE_MAX ) const { return i_roundIndex >= m_rounds.size() ? m_rounds.back() : m_rounds[ i_roundIndex ]; }
+	Round const& GetRound( size_t i_roundIndex = SIZE_MAX ) const { return *( i_roundIndex >= m_rounds.size() ? m_rounds.back() : m_rounds[ i_roundIndex ] ); }
 	TableEvent RetrieveEvent()
 	{
 		TableEvent event = std::move( m_mostRecentEvent );
 		m_mostRecentEvent = Utils::NullType{};
 		return event;
 	}
+	// Takes the next step on a table where every player is an AI: starting games and rounds, making AI decisions, and passing on calls.
+	// Returns false without doing anything once the game is over, or if it's somehow a user's turn.
+	// The step's event is left to be retrieved as usual.
+	bool AdvanceAIOnly();
+
+	// Evaluation caching, off by default as it only pays off when many hands repeat
+	void EnableEvaluationCache( size_t i_capacity );
+	HandEvaluationCache const* GetEvaluationCache() const { return m_evaluationCache.get(); }
 
 	AIRNG& GetAIRNG() { return m_aiRNG; }
 	AI::DecisionToken MakeNewAIDecisionToken() { return m_aiTokens(); }
 
 private:
+	struct ForkTag {};
+	Table( Table const& i_table, Vector<Player>&& i_players, ForkTag );
+
 	void Transition( TableState&& i_nextState, TableEvent&& i_nextEvent );
+
+	// Asks the rules for the waits of a player's current hand, through the evaluation cache if enabled
+	Pair<TileKindSet, Vector<TileInstance>> WaitsWithYaku( Round const& i_round, Seat i_playerSeat, TileDraw const& i_lastTile, bool i_considerForRiichi );
 };
 
 }
@@ -15,7 +15,7 @@ void BetweenTurnsBase::TransitionToTurn
 {
 	Table& table = m_table.get();
 
-	Round& round = table.m_rounds.back();
+	Round& round = *table.m_rounds.back();
 
 	// Any pending riichi bets should now be applied, as it's the start of the next turn
 	for ( Seat player : round.Seats() )
@@ -44,19 +44,23 @@ void BetweenTurnsBase::TransitionToTurn
 		bool const allowedToRiichi = playerHand.Melds().empty()
 			&& !isRiichi
 			&& table.m_rules->HasPermissionToRiichi( round.CurrentTurn(), table.GetPoints( round.GetPlayerID( round.CurrentTurn() ) ) );
-		auto [validWaits, validRiichiDiscards] = table.m_rules->WaitsWithYaku(
+		auto [validWaits, validRiichiDiscards] = table.WaitsWithYaku(
 			round,
 			round.CurrentTurn(),
-			playerHand,
 			i_tileDraw.value(),
 			allowedToRiichi
 		);
 
-		canTsumo = validWaits.contains( i_tileDraw.value().m_tile.Tile() );
+		canTsumo = validWaits.Contains( i_tileDraw.value().m_tile.Tile() );
 		riichiDiscards = std::move( validRiichiDiscards );
 	}
 
-	Vector<HandKanOption> kanOptions = round.CurrentHand( round.CurrentTurn() ).HandKanOptions( i_tileDraw ? Option<TileInstance>( i_tileDraw->m_tile ) : Option<TileInstance>() );
+	// A kan needs a replacement tile, so there can't be one from the last tile of the wall, or once the dead wall is used up
+	Vector<HandKanOption> kanOptions;
+	if ( round.WallTilesRemaining() > 0u && round.DeadWallDrawsRemaining() > 0u )
+	{
+		kanOptions = round.CurrentHand( round.CurrentTurn() ).HandKanOptions( i_tileDraw ? Option<TileInstance>( i_tileDraw->m_tile ) : Option<TileInstance>() );
+	}
 
 	switch ( turnPlayer.Type() )
 	{
@@ -88,7 +92,7 @@ void BetweenTurnsBase::HandleRon
 {
 	Table& table = m_table.get();
 
-	Round& round = table.m_rounds.back();
+	Round& round = *table.m_rounds.back();
 
 	// TODO-AI: assess whether any AI should join in ron
 	// TODO-RULES: allow/disallow multiple ron
@@ -108,6 +112,7 @@ void BetweenTurnsBase::HandleRon
 			round,
 			winner,
 			hand,
+			round.CurrentHandAssessment( winner ),
 			i_tileDraw
 		);
 
@@ -164,26 +169,28 @@ void BetweenRounds::StartRound
 	if ( table.m_rounds.empty() )
 	{
 		// First round starts on east, shuffle players
-		table.m_rounds.emplace_back(
+		table.m_rounds.push_back( std::make_shared<Round>(
 			Seat::East,
 			table.m_playerIDs,
 			*table.m_rules,
 			table.m_shuffleRNG
-		);
+		) );
 	}
 	else
 	{
-		// Follow from last round
-		Round const& previousRound = table.m_rounds.back();
-		table.m_rounds.emplace_back(
+		// Follow from last round, which is finished with and so may be shared by forks that outlive this table's cache
+		Round& previousRound = *table.m_rounds.back();
+		previousRound.UseEvaluationCache( nullptr );
+		table.m_rounds.push_back( std::make_shared<Round>(
 			table,
 			previousRound,
 			*table.m_rules,
 			table.m_shuffleRNG
-		);
+		) );
 	}
 
-	Round& round = table.m_rounds.back();
+	Round& round = *table.m_rounds.back();
+	round.UseEvaluationCache( table.m_evaluationCache.get() );
 
 	TileDraw const firstDrawnTile = round.DealHands();
 
@@ -243,7 +250,7 @@ void BaseTurn::TransitionToBetweenTurns
 {
 	Table& table = m_table.get();
 
-	Round& round = table.m_rounds.back();
+	Round& round = *table.m_rounds.back();
 
 	Seat const nextPlayer = NextPlayer( round.CurrentTurn(), table.m_players.size() );
 	BetweenTurns::ChiOptionData canChi;
@@ -271,18 +278,20 @@ void BaseTurn::TransitionToBetweenTurns
 		if ( !isRiichi )
 		{
 			canPon[seat] = round.CurrentHand( seat ).PonOptions( i_discardedTile.Tile() );
-			canKan[seat] = round.CurrentHand( seat ).KanOptions( i_discardedTile.Tile() );
+			if ( round.WallTilesRemaining() > 0u && round.DeadWallDrawsRemaining() > 0u )
+			{
+				canKan[seat] = round.CurrentHand( seat ).KanOptions( i_discardedTile.Tile() );
+			}
 		}
 
 		bool constexpr c_allowedToRiichi = false;
-		auto const [ validWaits, canRiichi ] = table.m_rules->WaitsWithYaku(
+		auto const [ validWaits, canRiichi ] = table.WaitsWithYaku(
 			round,
 			seat,
-			round.CurrentHand( seat ),
 			discardedTileAsDraw,
 			c_allowedToRiichi
 		);
-		if ( !validWaits.empty() && !round.Furiten( seat, validWaits ) )
+		if ( !validWaits.Empty() && !round.Furiten( seat, validWaits ) )
 		{
 			canRon.Insert( seat );
 		}
@@ -330,7 +339,7 @@ void BaseTurn::Tsumo
 
 	riEnsure( m_canTsumo, "This user cannot tsumo" );
 
-	Round& round = table.m_rounds.back();
+	Round& round = *table.m_rounds.back();
 
 	Seat const winner = round.CurrentTurn();
 
@@ -346,6 +355,7 @@ void BaseTurn::Tsumo
 		round,
 		winner,
 		hand,
+		round.CurrentHandAssessment( winner ),
 		tileDraw
 	);
 
@@ -381,7 +391,7 @@ void BaseTurn::Discard
 {
 	Table& table = m_table.get();
 
-	Round& round = table.m_rounds.back();
+	Round& round = *table.m_rounds.back();
 	TileInstance const discardedTile = round.Discard( i_handTileToDiscard );
 
 	TransitionToBetweenTurns(
@@ -400,7 +410,7 @@ void BaseTurn::Riichi
 
 	riEnsure( CanRiichi(), "This user cannot riichi" );
 
-	Round& round = table.m_rounds.back();
+	Round& round = *table.m_rounds.back();
 
 	riEnsure(
 		i_handTileToDiscard.has_value()
@@ -429,7 +439,7 @@ void BaseTurn::Kan
 
 	riEnsure( std::ranges::contains( m_kanOptions, i_kanOption ), "This user cannot kan with provided option" );
 
-	Round& round = table.m_rounds.back();
+	Round& round = *table.m_rounds.back();
 	Seat const player = round.CurrentTurn();
 	Option<TileDraw> const drawnTile = round.CurrentTileDraw( player );
 
@@ -447,14 +457,13 @@ void BaseTurn::Kan
 			continue;
 		}
 		bool constexpr c_allowedToRiichi = false;
-		auto const [validWaits, canRiichi] = table.m_rules->WaitsWithYaku(
+		auto const [validWaits, canRiichi] = table.WaitsWithYaku(
 			round,
 			seat,
-			round.CurrentHand( seat ),
 			kanTileTheft,
 			c_allowedToRiichi
 		);
-		if ( !validWaits.empty() && !round.Furiten( seat, validWaits ) )
+		if ( !validWaits.Empty() && !round.Furiten( seat, validWaits ) )
 		{
 			canRon.Insert( seat );
 		}
@@ -499,7 +508,7 @@ void Turn_AI::MakeDecision
 {
 	Table& table = m_table.get();
 
-	Round& round = table.m_rounds.back();
+	Round& round = *table.m_rounds.back();
 	Player const& currentPlayer = round.GetPlayer( round.CurrentTurn(), table );
 
 	riEnsure( currentPlayer.Type() == PlayerType::AI, "Must be AI player on AI turn state" );
@@ -623,7 +632,7 @@ void BetweenTurns::UserPass
 {
 	Table& table = m_table.get();
 
-	Round& round = table.m_rounds.back();
+	Round& round = *table.m_rounds.back();
 
 	// First check if there are rons to process, as that takes precedence
 	SeatSet aiWouldRon;
@@ -677,7 +686,7 @@ void BetweenTurns::UserPass
 		for ( size_t seatI = 0; seatI < table.m_players.size(); ++seatI )
 		{
 			Seat const seat = ( Seat )seatI;
-			if ( !HandAssessment( round.CurrentHand( seat ), *table.m_rules ).Waits().empty() )
+			if ( !round.CurrentHandAssessment( seat ).Waits().Empty() )
 			{
 				round.AddFinishedInTenpai( seat );
 				inTenpai.Insert( seat );
@@ -722,7 +731,7 @@ void BetweenTurns::UserChi
 {
 	Table& table = m_table.get();
 
-	Round& round = table.m_rounds.back();
+	Round& round = *table.m_rounds.back();
 	Meld::CalledTile const calledTile = round.Chi( i_user, i_option );
 
 	TransitionToTurn(
@@ -740,7 +749,7 @@ void BetweenTurns::UserPon
 {
 	Table& table = m_table.get();
 
-	Round& round = table.m_rounds.back();
+	Round& round = *table.m_rounds.back();
 	Meld::CalledTile const calledTile = round.Pon( i_user, i_option );
 
 	TransitionToTurn(
@@ -758,7 +767,7 @@ void BetweenTurns::UserKan
 {
 	Table& table = m_table.get();
 
-	Round& round = table.m_rounds.back();
+	Round& round = *table.m_rounds.back();
 	auto const [ deadWallDraw, calledTile ] = round.DiscardKan( i_user, i_option );
 
 	TransitionToTurn(
@@ -795,7 +804,7 @@ void BetweenTurns_PendingAI::AdvanceDecisionCalculations
 {
 	Table& table = m_table.get();
 
-	Round& round = table.m_rounds.back();
+	Round& round = *table.m_rounds.back();
 
 	bool allAIDecided = true;
 	Utils::EnumArray<AI::BetweenTurnsDecisionData, Seats> aiDecisions;
@@ -845,7 +854,7 @@ void RonAKanChance::Pass
 {
 	Table& table = m_table.get();
 
-	Round& round = table.m_rounds.back();
+	Round& round = *table.m_rounds.back();
 	TileDraw const deadWallDraw = round.HandKanRonPass();
 
 	TransitionToTurn(
@@ -57,6 +57,11 @@ struct Base
 	Base( Table& i_table ) : m_table{ i_table } {}
 protected:
 	std::reference_wrapper<Table> m_table;
+
+private:
+	// A forked table starts with a copy of the state, which then needs pointing at the new table
+	friend class Riichi::Table;
+	void Rebind( Table& i_table ) { m_table = i_table; }
 };
 
 //------------------------------------------------------------------------------
@@ -224,6 +229,8 @@ struct BetweenTurns_PendingAI
 {
 	using BetweenTurns::BetweenTurns;
 
+	friend class Riichi::Table; // To rebind when forking
+
 	void AdvanceDecisionCalculations() const;
 };
 
@@ -3,6 +3,7 @@
 #include "NamedUnion.hpp"
 #include "Utils.hpp"
 
+#include <atomic>
 #include <iostream>
 
 namespace Riichi
@@ -138,14 +139,125 @@ public:
 	template <typename T> friend struct std::hash;
 };
 
+//------------------------------------------------------------------------------
+// A dense index for every TileKind, in sorted order (manzu, pinzu, souzu, dragons, winds).
+// Converts to and from a TileKind without branching on ranges, and answers property
+// and successor queries with a single lookup into constexpr tables.
+//------------------------------------------------------------------------------
+class TileKindIndex
+{
+	uint8_t m_index;
+
+public:
+	static constexpr size_t c_count = Suits::Count() * Numbers::Count() + Honours::Count();
+
+	constexpr explicit TileKindIndex( size_t i_index )
+		: m_index{ static_cast< uint8_t >( i_index ) }
+	{
+		riEnsure( i_index < c_count, "Tile kind index out of range" );
+	}
+	constexpr TileKindIndex( TileKind i_kind )
+		: m_index{ static_cast< uint8_t >( i_kind.IsNumber()
+			? Suits::ValueToIndex( i_kind.Suit() ) * Numbers::Count() + Numbers::ValueToIndex( i_kind.Face() )
+			: Suits::Count() * Numbers::Count() + Honours::ValueToIndex( i_kind.Face() ) ) }
+	{}
+
+	constexpr operator size_t() const { return m_index; }
+	inline constexpr TileKind Kind() const;
+
+	inline constexpr bool IsNumber() const;
+	inline constexpr bool IsSimple() const;
+	inline constexpr bool IsTerminal() const;
+	inline constexpr bool IsHonour() const;
+	inline constexpr bool IsDragon() const;
+	inline constexpr bool IsWind() const;
+	inline constexpr bool IsHonourOrTerminal() const;
+
+	inline constexpr TileKindIndex Next() const;
+	inline constexpr TileKindIndex Prev() const;
+
+	friend constexpr bool operator==( TileKindIndex i_a, TileKindIndex i_b ) = default;
+};
+
+//------------------------------------------------------------------------------
+namespace Detail
+{
+
+struct TileKindData
+{
+	enum Flags : uint8_t
+	{
+		Number = 1 << 0,
+		Simple = 1 << 1,
+		Terminal = 1 << 2,
+		Honour = 1 << 3,
+		Dragon = 1 << 4,
+		Wind = 1 << 5,
+	};
+
+	Suit m_suit{ Suit::None };
+	Face m_face{ Face::Haku };
+	uint8_t m_flags{ 0 };
+	uint8_t m_next{ 0 };
+	uint8_t m_prev{ 0 };
+};
+
+inline constexpr Array<TileKindData, TileKindIndex::c_count> c_tileKindData = []
+{
+	Array<TileKindData, TileKindIndex::c_count> data{};
+	for ( size_t kindI = 0; kindI < TileKindIndex::c_count; ++kindI )
+	{
+		size_t constexpr c_numberKinds = Suits::Count() * Numbers::Count();
+		TileKind const kind = kindI < c_numberKinds
+			? TileKind{ Suits::IndexToValue( kindI / Numbers::Count() ), Numbers::IndexToValue( kindI % Numbers::Count() ) }
+			: TileKind{ Honours::IndexToValue( kindI - c_numberKinds ) };
+
+		TileKindData& entry = data[ kindI ];
+		entry.m_suit = kind.Suit();
+		entry.m_face = kind.Face();
+		entry.m_flags = static_cast< uint8_t >(
+			( kind.IsNumber() ? TileKindData::Number : 0 )
+			| ( kind.IsSimple() ? TileKindData::Simple : 0 )
+			| ( kind.IsTerminal() ? TileKindData::Terminal : 0 )
+			| ( kind.IsHonour() ? TileKindData::Honour : 0 )
+			| ( kind.IsDragon() ? TileKindData::Dragon : 0 )
+			| ( kind.IsWind() ? TileKindData::Wind : 0 )
+		);
+		entry.m_next = static_cast< uint8_t >( TileKindIndex{ kind.Next() } );
+		entry.m_prev = static_cast< uint8_t >( TileKindIndex{ kind.Prev() } );
+	}
+	return data;
+}();
+
+}
+
+//------------------------------------------------------------------------------
+inline constexpr TileKind TileKindIndex::Kind() const
+{
+	Detail::TileKindData const& entry = Detail::c_tileKindData[ m_index ];
+	return entry.m_suit == Suit::None ? TileKind{ entry.m_face } : TileKind{ entry.m_suit, entry.m_face };
+}
+
+inline constexpr bool TileKindIndex::IsNumber() const { return Detail::c_tileKindData[ m_index ].m_flags & Detail::TileKindData::Number; }
+inline constexpr bool TileKindIndex::IsSimple() const { return Detail::c_tileKindData[ m_index ].m_flags & Detail::TileKindData::Simple; }
+inline constexpr bool TileKindIndex::IsTerminal() const { return Detail::c_tileKindData[ m_index ].m_flags & Detail::TileKindData::Terminal; }
+inline constexpr bool TileKindIndex::IsHonour() const { return Detail::c_tileKindData[ m_index ].m_flags & Detail::TileKindData::Honour; }
+inline constexpr bool TileKindIndex::IsDragon() const { return Detail::c_tileKindData[ m_index ].m_flags & Detail::TileKindData::Dragon; }
+inline constexpr bool TileKindIndex::IsWind() const { return Detail::c_tileKindData[ m_index ].m_flags & Detail::TileKindData::Wind; }
+inline constexpr bool TileKindIndex::IsHonourOrTerminal() const { return Detail::c_tileKindData[ m_index ].m_flags & ( Detail::TileKindData::Honour | Detail::TileKindData::Terminal ); }
+
+inline constexpr TileKindIndex TileKindIndex::Next() const { return TileKindIndex{ size_t{ Detail::c_tileKindData[ m_index ].m_next } }; }
+inline constexpr TileKindIndex TileKindIndex::Prev() const { return TileKindIndex{ size_t{ Detail::c_tileKindData[ m_index ].m_prev } }; }
+
 //------------------------------------------------------------------------------
 // Special properties can be set on a tile. These are fully customisable by the ruleset, by instantiating Property.
 //------------------------------------------------------------------------------
 namespace Detail
 {
-static inline uint8_t s_flagCount = 0;
-inline uint8_t MakeTilePropertyFlag() { ++s_flagCount; riEnsure( s_flagCount < 8, "Too many properties registered" ); return ( 1 << ( s_flagCount - 1 ) ); }
-inline bool RegisteringTileProperties( bool i_flip ) { static bool s_registeringProperties = false; if ( i_flip ) { s_registeringProperties = !s_registeringProperties; } return s_registeringProperties; }
+// Bits are handed out to each property the first time it's used, and never change after that,
+// so a tile means the same to every ruleset and thread in the process.
+inline std::atomic<uint8_t> s_flagCount{ 0 };
+inline uint8_t MakeTilePropertyFlag() { uint8_t const flagI = s_flagCount.fetch_add( 1, std::memory_order_relaxed ); riEnsure( flagI < 8, "Too many properties registered" ); return uint8_t( 1 << flagI ); }
 }
 
 template<typename T_Tag>
@@ -153,23 +265,18 @@ struct TileProperty
 {
 	static uint8_t BitFlag()
 	{
-		static uint8_t s_flag = 0;
-		if ( Detail::RegisteringTileProperties( false ) )
-		{
-			s_flag = Detail::MakeTilePropertyFlag();
-		}
+		// Function-local statics are initialised exactly once, even with several threads racing to it
+		static uint8_t const s_flag = Detail::MakeTilePropertyFlag();
 		return s_flag;
 	}
 };
 
-// Call when setting up a ruleset.
+// Call when setting up a ruleset, so that its properties get bits in a fixed order rather than
+// in whatever order tiles happen to first use them. Safe to call again, and from any thread.
 template<typename... T_Tags>
 inline void RegisterTileProperties( TileProperty<T_Tags>... i_properties )
 {
-	Detail::s_flagCount = 0;
-	Detail::RegisteringTileProperties( true );
 	( i_properties.BitFlag(), ... );
-	Detail::RegisteringTileProperties( true );
 }
 
 class TileProperties
@@ -192,6 +299,9 @@ public:
 
 	template<typename T_Property>
 	constexpr bool HasProperty() const { return ( m_flags & T_Property::BitFlag() ) != 0; }
+
+	// All the property bits at once, for keying tables by a tile's full value
+	constexpr uint8_t Bits() const { return m_flags; }
 };
 
 //------------------------------------------------------------------------------
@@ -373,9 +483,10 @@ struct std::hash<Riichi::TileKind>
 	{
 		using namespace Riichi;
 
-		std::size_t h1 = std::hash<EnumValueType>{}( static_cast< EnumValueType >( i_tile.Suit() ) );
-		std::size_t h2 = std::hash<EnumValueType>{}( static_cast< EnumValueType >( i_tile.Face() ) );
-		return h1 ^ ( h2 << 1 );
+		// Suit and face each fit in a byte, so packing them side by side never collides
+		std::size_t const suit = static_cast< EnumValueType >( i_tile.Suit() );
+		std::size_t const face = static_cast< EnumValueType >( i_tile.Face() );
+		return std::hash<std::size_t>{}( ( suit << 8 ) | face );
 	}
 };
 
@@ -0,0 +1,412 @@
+#include "TileCountKernels.hpp"
+
+#include "Containers.hpp"
+#include "DebugUtils.hpp"
+
+#include <atomic>
+
+#if defined( __x86_64__ ) || defined( _M_X64 )
+#define RIICHI_COUNT_KERNELS_X64 1
+#include <immintrin.h>
+#if defined( _MSC_VER ) && !defined( __clang__ )
+#include <intrin.h>
+// MSVC allows any intrinsic without it being enabled for the whole build
+#define RIICHI_TARGET_AVX2
+#else
+#define RIICHI_TARGET_AVX2 __attribute__(( target( "avx2" ) ))
+#endif
+#else
+#define RIICHI_COUNT_KERNELS_X64 0
+#endif
+
+namespace Riichi
+{
+
+static constexpr size_t c_lanes = CountKernels::c_lanes;
+
+//------------------------------------------------------------------------------
+// Scalar
+//------------------------------------------------------------------------------
+static void AddScalar
+(
+	uint8_t* io_counts,
+	uint8_t const* i_other
+)
+{
+	for ( size_t laneI = 0; laneI < c_lanes; ++laneI )
+	{
+		io_counts[ laneI ] += i_other[ laneI ];
+	}
+}
+
+//------------------------------------------------------------------------------
+static bool SubtractScalar
+(
+	uint8_t* io_counts,
+	uint8_t const* i_other
+)
+{
+	bool valid = true;
+	for ( size_t laneI = 0; laneI < c_lanes; ++laneI )
+	{
+		valid &= io_counts[ laneI ] >= i_other[ laneI ];
+		io_counts[ laneI ] -= i_other[ laneI ];
+	}
+	return valid;
+}
+
+//------------------------------------------------------------------------------
+static uint64_t AtLeastMaskScalar
+(
+	uint8_t const* i_counts,
+	uint8_t i_min
+)
+{
+	uint64_t mask = 0;
+	for ( size_t laneI = 0; laneI < c_lanes; ++laneI )
+	{
+		mask |= uint64_t{ i_counts[ laneI ] >= i_min } << laneI;
+	}
+	return mask;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t DotScalar
+(
+	uint8_t const* i_a,
+	uint8_t const* i_b
+)
+{
+	uint32_t total = 0;
+	for ( size_t laneI = 0; laneI < c_lanes; ++laneI )
+	{
+		total += uint32_t{ i_a[ laneI ] } * i_b[ laneI ];
+	}
+	return total;
+}
+
+//------------------------------------------------------------------------------
+static void RemainingScalar
+(
+	uint8_t* o_remaining,
+	uint8_t const* i_counts,
+	uint8_t i_copies
+)
+{
+	for ( size_t laneI = 0; laneI < c_lanes; ++laneI )
+	{
+		o_remaining[ laneI ] = i_counts[ laneI ] >= i_copies ? 0 : static_cast< uint8_t >( i_copies - i_counts[ laneI ] );
+	}
+}
+
+#if RIICHI_COUNT_KERNELS_X64
+//------------------------------------------------------------------------------
+// SSE2, which every x86-64 CPU has. Two full registers, then the last two lanes by hand.
+//------------------------------------------------------------------------------
+static constexpr size_t c_sseLanes = 32;
+static_assert( c_lanes - c_sseLanes < 16 );
+
+//------------------------------------------------------------------------------
+static void AddSSE2
+(
+	uint8_t* io_counts,
+	uint8_t const* i_other
+)
+{
+	for ( size_t laneI = 0; laneI < c_sseLanes; laneI += 16 )
+	{
+		__m128i const counts = _mm_loadu_si128( reinterpret_cast< __m128i const* >( io_counts + laneI ) );
+		__m128i const other = _mm_loadu_si128( reinterpret_cast< __m128i const* >( i_other + laneI ) );
+		_mm_storeu_si128( reinterpret_cast< __m128i* >( io_counts + laneI ), _mm_add_epi8( counts, other ) );
+	}
+	for ( size_t laneI = c_sseLanes; laneI < c_lanes; ++laneI )
+	{
+		io_counts[ laneI ] += i_other[ laneI ];
+	}
+}
+
+//------------------------------------------------------------------------------
+static bool SubtractSSE2
+(
+	uint8_t* io_counts,
+	uint8_t const* i_other
+)
+{
+	int validMask = 0xFFFF;
+	for ( size_t laneI = 0; laneI < c_sseLanes; laneI += 16 )
+	{
+		__m128i const counts = _mm_loadu_si128( reinterpret_cast< __m128i const* >( io_counts + laneI ) );
+		__m128i const other = _mm_loadu_si128( reinterpret_cast< __m128i const* >( i_other + laneI ) );
+		// Unsigned a >= b exactly when max( a, b ) == a
+		validMask &= _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_max_epu8( counts, other ), counts ) );
+		_mm_storeu_si128( reinterpret_cast< __m128i* >( io_counts + laneI ), _mm_sub_epi8( counts, other ) );
+	}
+	bool valid = validMask == 0xFFFF;
+	for ( size_t laneI = c_sseLanes; laneI < c_lanes; ++laneI )
+	{
+		valid &= io_counts[ laneI ] >= i_other[ laneI ];
+		io_counts[ laneI ] -= i_other[ laneI ];
+	}
+	return valid;
+}
+
+//------------------------------------------------------------------------------
+static uint64_t AtLeastMaskSSE2
+(
+	uint8_t const* i_counts,
+	uint8_t i_min
+)
+{
+	__m128i const min = _mm_set1_epi8( static_cast< char >( i_min ) );
+	uint64_t mask = 0;
+	for ( size_t laneI = 0; laneI < c_sseLanes; laneI += 16 )
+	{
+		__m128i const counts = _mm_loadu_si128( reinterpret_cast< __m128i const* >( i_counts + laneI ) );
+		uint32_t const laneMask = static_cast< uint32_t >( _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_max_epu8( counts, min ), counts ) ) );
+		mask |= uint64_t{ laneMask } << laneI;
+	}
+	for ( size_t laneI = c_sseLanes; laneI < c_lanes; ++laneI )
+	{
+		mask |= uint64_t{ i_counts[ laneI ] >= i_min } << laneI;
+	}
+	return mask;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t DotSSE2
+(
+	uint8_t const* i_a,
+	uint8_t const* i_b
+)
+{
+	// Widen to 16 bits so that the products can't overflow, then pairwise multiply-add into 32 bits
+	__m128i const zero = _mm_setzero_si128();
+	__m128i sums = zero;
+	for ( size_t laneI = 0; laneI < c_sseLanes; laneI += 16 )
+	{
+		__m128i const a = _mm_loadu_si128( reinterpret_cast< __m128i const* >( i_a + laneI ) );
+		__m128i const b = _mm_loadu_si128( reinterpret_cast< __m128i const* >( i_b + laneI ) );
+		sums = _mm_add_epi32( sums, _mm_madd_epi16( _mm_unpacklo_epi8( a, zero ), _mm_unpacklo_epi8( b, zero ) ) );
+		sums = _mm_add_epi32( sums, _mm_madd_epi16( _mm_unpackhi_epi8( a, zero ), _mm_unpackhi_epi8( b, zero ) ) );
+	}
+	sums = _mm_add_epi32( sums, _mm_shuffle_epi32( sums, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+	sums = _mm_add_epi32( sums, _mm_shuffle_epi32( sums, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+	uint32_t total = static_cast< uint32_t >( _mm_cvtsi128_si32( sums ) );
+	for ( size_t laneI = c_sseLanes; laneI < c_lanes; ++laneI )
+	{
+		total += uint32_t{ i_a[ laneI ] } * i_b[ laneI ];
+	}
+	return total;
+}
+
+//------------------------------------------------------------------------------
+static void RemainingSSE2
+(
+	uint8_t* o_remaining,
+	uint8_t const* i_counts,
+	uint8_t i_copies
+)
+{
+	__m128i const copies = _mm_set1_epi8( static_cast< char >( i_copies ) );
+	for ( size_t laneI = 0; laneI < c_sseLanes; laneI += 16 )
+	{
+		__m128i const counts = _mm_loadu_si128( reinterpret_cast< __m128i const* >( i_counts + laneI ) );
+		_mm_storeu_si128( reinterpret_cast< __m128i* >( o_remaining + laneI ), _mm_subs_epu8( copies, counts ) );
+	}
+	for ( size_t laneI = c_sseLanes; laneI < c_lanes; ++laneI )
+	{
+		o_remaining[ laneI ] = i_counts[ laneI ] >= i_copies ? 0 : static_cast< uint8_t >( i_copies - i_counts[ laneI ] );
+	}
+}
+
+//------------------------------------------------------------------------------
+// AVX2. One full register, then the last two lanes by hand.
+//------------------------------------------------------------------------------
+RIICHI_TARGET_AVX2 static void AddAVX2
+(
+	uint8_t* io_counts,
+	uint8_t const* i_other
+)
+{
+	__m256i const counts = _mm256_loadu_si256( reinterpret_cast< __m256i const* >( io_counts ) );
+	__m256i const other = _mm256_loadu_si256( reinterpret_cast< __m256i const* >( i_other ) );
+	_mm256_storeu_si256( reinterpret_cast< __m256i* >( io_counts ), _mm256_add_epi8( counts, other ) );
+	for ( size_t laneI = c_sseLanes; laneI < c_lanes; ++laneI )
+	{
+		io_counts[ laneI ] += i_other[ laneI ];
+	}
+}
+
+//------------------------------------------------------------------------------
+RIICHI_TARGET_AVX2 static bool SubtractAVX2
+(
+	uint8_t* io_counts,
+	uint8_t const* i_other
+)
+{
+	__m256i const counts = _mm256_loadu_si256( reinterpret_cast< __m256i const* >( io_counts ) );
+	__m256i const other = _mm256_loadu_si256( reinterpret_cast< __m256i const* >( i_other ) );
+	bool valid = _mm256_movemask_epi8( _mm256_cmpeq_epi8( _mm256_max_epu8( counts, other ), counts ) ) == -1;
+	_mm256_storeu_si256( reinterpret_cast< __m256i* >( io_counts ), _mm256_sub_epi8( counts, other ) );
+	for ( size_t laneI = c_sseLanes; laneI < c_lanes; ++laneI )
+	{
+		valid &= io_counts[ laneI ] >= i_other[ laneI ];
+		io_counts[ laneI ] -= i_other[ laneI ];
+	}
+	return valid;
+}
+
+//------------------------------------------------------------------------------
+RIICHI_TARGET_AVX2 static uint64_t AtLeastMaskAVX2
+(
+	uint8_t const* i_counts,
+	uint8_t i_min
+)
+{
+	__m256i const counts = _mm256_loadu_si256( reinterpret_cast< __m256i const* >( i_counts ) );
+	__m256i const min = _mm256_set1_epi8( static_cast< char >( i_min ) );
+	uint64_t mask = static_cast< uint32_t >( _mm256_movemask_epi8( _mm256_cmpeq_epi8( _mm256_max_epu8( counts, min ), counts ) ) );
+	for ( size_t laneI = c_sseLanes; laneI < c_lanes; ++laneI )
+	{
+		mask |= uint64_t{ i_counts[ laneI ] >= i_min } << laneI;
+	}
+	return mask;
+}
+
+//------------------------------------------------------------------------------
+RIICHI_TARGET_AVX2 static uint32_t DotAVX2
+(
+	uint8_t const* i_a,
+	uint8_t const* i_b
+)
+{
+	__m128i const aLow = _mm_loadu_si128( reinterpret_cast< __m128i const* >( i_a ) );
+	__m128i const aHigh = _mm_loadu_si128( reinterpret_cast< __m128i const* >( i_a + 16 ) );
+	__m128i const bLow = _mm_loadu_si128( reinterpret_cast< __m128i const* >( i_b ) );
+	__m128i const bHigh = _mm_loadu_si128( reinterpret_cast< __m128i const* >( i_b + 16 ) );
+	__m256i sums = _mm256_add_epi32(
+		_mm256_madd_epi16( _mm256_cvtepu8_epi16( aLow ), _mm256_cvtepu8_epi16( bLow ) ),
+		_mm256_madd_epi16( _mm256_cvtepu8_epi16( aHigh ), _mm256_cvtepu8_epi16( bHigh ) )
+	);
+
+	__m128i halves = _mm_add_epi32( _mm256_castsi256_si128( sums ), _mm256_extracti128_si256( sums, 1 ) );
+	halves = _mm_add_epi32( halves, _mm_shuffle_epi32( halves, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+	halves = _mm_add_epi32( halves, _mm_shuffle_epi32( halves, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+	uint32_t total = static_cast< uint32_t >( _mm_cvtsi128_si32( halves ) );
+	for ( size_t laneI = c_sseLanes; laneI < c_lanes; ++laneI )
+	{
+		total += uint32_t{ i_a[ laneI ] } * i_b[ laneI ];
+	}
+	return total;
+}
+
+//------------------------------------------------------------------------------
+RIICHI_TARGET_AVX2 static void RemainingAVX2
+(
+	uint8_t* o_remaining,
+	uint8_t const* i_counts,
+	uint8_t i_copies
+)
+{
+	__m256i const counts = _mm256_loadu_si256( reinterpret_cast< __m256i const* >( i_counts ) );
+	_mm256_storeu_si256( reinterpret_cast< __m256i* >( o_remaining ), _mm256_subs_epu8( _mm256_set1_epi8( static_cast< char >( i_copies ) ), counts ) );
+	for ( size_t laneI = c_sseLanes; laneI < c_lanes; ++laneI )
+	{
+		o_remaining[ laneI ] = i_counts[ laneI ] >= i_copies ? 0 : static_cast< uint8_t >( i_copies - i_counts[ laneI ] );
+	}
+}
+
+//------------------------------------------------------------------------------
+static bool CPUSupportsAVX2
+(
+)
+{
+#if defined( _MSC_VER ) && !defined( __clang__ )
+	int info[ 4 ];
+	__cpuid( info, 0 );
+	if ( info[ 0 ] < 7 )
+	{
+		return false;
+	}
+	__cpuid( info, 1 );
+	bool const osSavesAVX = ( info[ 2 ] & ( 1 << 27 ) ) != 0 && ( _xgetbv( 0 ) & 0x6 ) == 0x6;
+	__cpuidex( info, 7, 0 );
+	return osSavesAVX && ( info[ 1 ] & ( 1 << 5 ) ) != 0;
+#else
+	return __builtin_cpu_supports( "avx2" );
+#endif
+}
+#endif
+
+//------------------------------------------------------------------------------
+static constexpr Array<CountKernels, 3> c_kernels{ {
+	{ AddScalar, SubtractScalar, AtLeastMaskScalar, DotScalar, RemainingScalar },
+#if RIICHI_COUNT_KERNELS_X64
+	{ AddSSE2, SubtractSSE2, AtLeastMaskSSE2, DotSSE2, RemainingSSE2 },
+	{ AddAVX2, SubtractAVX2, AtLeastMaskAVX2, DotAVX2, RemainingAVX2 },
+#else
+	{ AddScalar, SubtractScalar, AtLeastMaskScalar, DotScalar, RemainingScalar },
+	{ AddScalar, SubtractScalar, AtLeastMaskScalar, DotScalar, RemainingScalar },
+#endif
+} };
+
+//------------------------------------------------------------------------------
+static CountKernelLevel BestSupportedLevel
+(
+)
+{
+#if RIICHI_COUNT_KERNELS_X64
+	return CPUSupportsAVX2() ? CountKernelLevel::AVX2 : CountKernelLevel::SSE2;
+#else
+	return CountKernelLevel::Scalar;
+#endif
+}
+
+//------------------------------------------------------------------------------
+static std::atomic<CountKernelLevel>& ActiveLevelStorage
+(
+)
+{
+	static std::atomic<CountKernelLevel> level{ BestSupportedLevel() };
+	return level;
+}
+
+//------------------------------------------------------------------------------
+/*static*/ CountKernels const& CountKernels::Active
+(
+)
+{
+	return c_kernels[ static_cast< size_t >( ActiveLevel() ) ];
+}
+
+//------------------------------------------------------------------------------
+/*static*/ CountKernelLevel CountKernels::ActiveLevel
+(
+)
+{
+	return ActiveLevelStorage().load( std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+/*static*/ bool CountKernels::Supported
+(
+	CountKernelLevel i_level
+)
+{
+	static CountKernelLevel const c_best = BestSupportedLevel();
+	return i_level <= c_best;
+}
+
+//------------------------------------------------------------------------------
+/*static*/ void CountKernels::Use
+(
+	CountKernelLevel i_level
+)
+{
+	riEnsure( Supported( i_level ), "Count kernel level isn't supported by this CPU" );
+	ActiveLevelStorage().store( i_level, std::memory_order_relaxed );
+}
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Base.hpp"
+
+#include <cstddef>
+
+namespace Riichi
+{
+
+//------------------------------------------------------------------------------
+// Byte-wise operations over the lanes of a TileCounts, one lane per tile kind.
+// There's a portable scalar version of each, plus SSE2 and AVX2 versions on x86-64.
+// The best level the CPU supports is picked at runtime, so the library never needs
+// building for anything newer than baseline x86-64.
+//------------------------------------------------------------------------------
+enum class CountKernelLevel : EnumValueType
+{
+	Scalar,
+	SSE2,
+	AVX2,
+};
+
+struct CountKernels
+{
+	static constexpr size_t c_lanes = 34;
+
+	void ( *m_add )( uint8_t* io_counts, uint8_t const* i_other );
+	// Returns false if any lane went below zero
+	bool ( *m_subtract )( uint8_t* io_counts, uint8_t const* i_other );
+	// A bit per lane holding at least i_min, in lane order
+	uint64_t ( *m_atLeastMask )( uint8_t const* i_counts, uint8_t i_min );
+	uint32_t ( *m_dot )( uint8_t const* i_a, uint8_t const* i_b );
+	// i_copies less each lane, stopping at zero
+	void ( *m_remaining )( uint8_t* o_remaining, uint8_t const* i_counts, uint8_t i_copies );
+
+	// The kernels in use, which are the best supported unless changed with Use()
+	static CountKernels const& Active();
+	static CountKernelLevel ActiveLevel();
+	static bool Supported( CountKernelLevel i_level );
+	// Mainly for tests and benchmarks to compare levels. The level must be supported.
+	static void Use( CountKernelLevel i_level );
+};
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Containers.hpp"
+#include "Declare.hpp"
+#include "Tile.hpp"
+
+#include <algorithm>
+
+namespace Riichi
+{
+
+//------------------------------------------------------------------------------
+// A histogram of the tile kinds in a set of tiles, plus a side-count of akadora.
+// Kinds are laid out in sorted order (manzu, pinzu, souzu, dragons, winds), so
+// walking the counts front to back visits tiles exactly as a sorted list would.
+//------------------------------------------------------------------------------
+class TileCounts
+{
+public:
+	TileCounts() = default;
+	template<TileInstanceRange TileInstances = DefaultTileInstanceRange>
+	explicit TileCounts( TileInstances&& i_tiles );
+
+	void Add( Tile const& i_tile );
+	void Add( TileKind i_kind, uint8_t i_count = 1 );
+	void Add( TileCounts const& i_other );
+	void Remove( Tile const& i_tile );
+	void Remove( TileKind i_kind, uint8_t i_count = 1 );
+	void Remove( TileCounts const& i_other );
+
+	uint8_t operator[]( TileKindIndex i_kind ) const { return m_counts[ i_kind ]; }
+	uint8_t operator[]( size_t i_index ) const { return m_counts[ i_index ]; }
+	uint8_t AkadoraCount() const { return m_akadora; }
+	size_t Total() const { return m_total; }
+	bool Empty() const { return m_total == 0; }
+	size_t DistinctKinds() const;
+
+	// Whole-histogram queries, done a register at a time through CountKernels
+	// A bit per kind held at least i_min times, laid out as in TileKindSet
+	uint64_t KindMask( uint8_t i_min = 1 ) const;
+	// Each tile counted once for every copy of its kind in i_kinds, e.g. to count dora against the indicated kinds
+	size_t CountMatches( TileCounts const& i_kinds ) const;
+	// How many of i_copies of each kind aren't accounted for by these counts, e.g. the unseen tiles given the visible ones
+	TileCounts Remaining( uint8_t i_copies ) const;
+
+	// Expands back out to a sorted list of tiles, without any properties
+	template<typename T_Container>
+	void AppendSortedTiles( T_Container& io_tiles ) const;
+
+	// Calls i_fn( TileKind, count ) for every kind present, in sorted order
+	template<typename T_Fn>
+	void ForEachKind( T_Fn&& i_fn ) const;
+
+	friend bool operator==( TileCounts const& i_a, TileCounts const& i_b ) = default;
+
+private:
+	Array<uint8_t, TileKindIndex::c_count> m_counts{};
+	uint8_t m_akadora{ 0 };
+	uint8_t m_total{ 0 };
+};
+
+}
+
+#include "TileCounts.inl"
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "TileCounts.hpp"
+#include "TileCountKernels.hpp"
+
+namespace Riichi
+{
+
+static_assert( CountKernels::c_lanes == TileKindIndex::c_count, "Count kernels must cover every tile kind" );
+
+//------------------------------------------------------------------------------
+template<TileInstanceRange TileInstances>
+TileCounts::TileCounts
+(
+	TileInstances&& i_tiles
+)
+{
+	for ( TileInstance const& tile : i_tiles )
+	{
+		Add( tile.Tile() );
+	}
+}
+
+//------------------------------------------------------------------------------
+inline void TileCounts::Add
+(
+	Tile const& i_tile
+)
+{
+	Add( i_tile.Kind() );
+	if ( i_tile.HasProperty<Akadora>() )
+	{
+		++m_akadora;
+	}
+}
+
+//------------------------------------------------------------------------------
+inline void TileCounts::Add
+(
+	TileKind i_kind,
+	uint8_t i_count
+)
+{
+	m_counts[ TileKindIndex{ i_kind } ] += i_count;
+	m_total += i_count;
+}
+
+//------------------------------------------------------------------------------
+inline void TileCounts::Add
+(
+	TileCounts const& i_other
+)
+{
+	CountKernels::Active().m_add( m_counts.data(), i_other.m_counts.data() );
+	m_akadora += i_other.m_akadora;
+	m_total += i_other.m_total;
+}
+
+//------------------------------------------------------------------------------
+inline void TileCounts::Remove
+(
+	Tile const& i_tile
+)
+{
+	Remove( i_tile.Kind() );
+	if ( i_tile.HasProperty<Akadora>() )
+	{
+		riEnsure( m_akadora > 0, "Removed more akadora than were counted" );
+		--m_akadora;
+	}
+}
+
+//------------------------------------------------------------------------------
+inline void TileCounts::Remove
+(
+	TileKind i_kind,
+	uint8_t i_count
+)
+{
+	uint8_t& count = m_counts[ TileKindIndex{ i_kind } ];
+	riEnsure( count >= i_count, "Removed more tiles of a kind than were counted" );
+	count -= i_count;
+	m_total -= i_count;
+}
+
+//------------------------------------------------------------------------------
+inline void TileCounts::Remove
+(
+	TileCounts const& i_other
+)
+{
+	[[maybe_unused]] bool const valid = CountKernels::Active().m_subtract( m_counts.data(), i_other.m_counts.data() );
+	riEnsure( valid && m_akadora >= i_other.m_akadora, "Removed more tiles of a kind than were counted" );
+	m_akadora -= i_other.m_akadora;
+	m_total -= i_other.m_total;
+}
+
+//------------------------------------------------------------------------------
+inline size_t TileCounts::DistinctKinds
+(
+)	const
+{
+	return static_cast< size_t >( std::ranges::count_if( m_counts, []( uint8_t i_count ) { return i_count > 0; } ) );
+}
+
+//------------------------------------------------------------------------------
+inline uint64_t TileCounts::KindMask
+(
+	uint8_t i_min
+)	const
+{
+	return CountKernels::Active().m_atLeastMask( m_counts.data(), i_min );
+}
+
+//------------------------------------------------------------------------------
+inline size_t TileCounts::CountMatches
+(
+	TileCounts const& i_kinds
+)	const
+{
+	return CountKernels::Active().m_dot( m_counts.data(), i_kinds.m_counts.data() );
+}
+
+//------------------------------------------------------------------------------
+inline TileCounts TileCounts::Remaining
+(
+	uint8_t i_copies
+)	const
+{
+	TileCounts remaining;
+	CountKernels::Active().m_remaining( remaining.m_counts.data(), m_counts.data(), i_copies );
+	for ( uint8_t count : remaining.m_counts )
+	{
+		remaining.m_total += count;
+	}
+	return remaining;
+}
+
+//------------------------------------------------------------------------------
+template<typename T_Container>
+void TileCounts::AppendSortedTiles
+(
+	T_Container& io_tiles
+)	const
+{
+	ForEachKind(
+		[ &io_tiles ]( TileKind i_kind, uint8_t i_count )
+		{
+			for ( uint8_t i = 0; i < i_count; ++i )
+			{
+				io_tiles.push_back( Tile{ i_kind } );
+			}
+		}
+	);
+}
+
+//------------------------------------------------------------------------------
+template<typename T_Fn>
+void TileCounts::ForEachKind
+(
+	T_Fn&& i_fn
+)	const
+{
+	for ( size_t kindI = 0; kindI < TileKindIndex::c_count; ++kindI )
+	{
+		if ( m_counts[ kindI ] > 0 )
+		{
+			i_fn( TileKindIndex{ kindI }.Kind(), m_counts[ kindI ] );
+		}
+	}
+}
+
+}
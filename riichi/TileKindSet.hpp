@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Containers.hpp"
+#include "Declare.hpp"
+#include "RangeUtils.hpp"
+#include "Tile.hpp"
+#include "TileCounts.hpp"
+
+namespace Riichi
+{
+
+//------------------------------------------------------------------------------
+// A set of tile kinds, stored as one bit per kind in the same order as TileCounts.
+// Iterates in sorted order.
+//------------------------------------------------------------------------------
+class TileKindSet
+{
+	uint64_t m_mask{ 0 };
+
+public:
+	struct BaseIter
+	{
+		using reference = TileKind;
+		using pointer = void;
+
+		uint64_t m_remaining;
+
+		// Default member initialisers aren't usable until TileKindSet is complete, which the iterator concepts need sooner
+		BaseIter() : m_remaining{ 0 } {}
+		explicit BaseIter( uint64_t i_remaining ) : m_remaining{ i_remaining } {}
+
+		BaseIter& operator++() { m_remaining &= m_remaining - 1; return *this; }
+		inline TileKind operator*() const;
+		bool operator==( BaseIter const& b ) const { return m_remaining == b.m_remaining; }
+	};
+
+	using Iter = Utils::ConstIteratorInterface<BaseIter>;
+
+	Iter begin() const { return Iter{ m_mask }; }
+	Iter end() const { return Iter{ 0 }; }
+
+	TileKindSet() = default;
+	TileKindSet( std::initializer_list<TileKind> i_kinds ) { for ( TileKind kind : i_kinds ) { Insert( kind ); } }
+	// Every kind held at least i_min times
+	explicit TileKindSet( TileCounts const& i_counts, uint8_t i_min = 1 ) : m_mask{ i_counts.KindMask( i_min ) } {}
+
+	inline void Insert( TileKindIndex i_kind );
+	inline void Erase( TileKindIndex i_kind );
+	inline bool Contains( TileKindIndex i_kind ) const;
+	bool ContainsAllOf( TileKindSet const& i_o ) const { return ( m_mask & i_o.m_mask ) == i_o.m_mask; }
+	bool Intersects( TileKindSet const& i_o ) const { return ( m_mask & i_o.m_mask ) != 0; }
+	inline size_t Size() const;
+	bool Empty() const { return m_mask == 0; }
+	void Clear() { m_mask = 0; }
+
+	TileKindSet& operator|=( TileKindSet const& i_o ) { m_mask |= i_o.m_mask; return *this; }
+	TileKindSet& operator&=( TileKindSet const& i_o ) { m_mask &= i_o.m_mask; return *this; }
+	TileKindSet& operator-=( TileKindSet const& i_o ) { m_mask &= ~i_o.m_mask; return *this; }
+	friend TileKindSet operator|( TileKindSet a, TileKindSet const& b ) { return a |= b; }
+	friend TileKindSet operator&( TileKindSet a, TileKindSet const& b ) { return a &= b; }
+	friend TileKindSet operator-( TileKindSet a, TileKindSet const& b ) { return a -= b; }
+
+	friend bool operator==( TileKindSet const& i_a, TileKindSet const& i_b ) = default;
+};
+
+}
+
+#include "TileKindSet.inl"
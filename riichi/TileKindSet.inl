@@ -0,0 +1,54 @@
+#pragma once
+
+#include "TileKindSet.hpp"
+
+#include <bit>
+
+namespace Riichi
+{
+
+//------------------------------------------------------------------------------
+inline TileKind TileKindSet::BaseIter::operator*
+(
+)	const
+{
+	riEnsure( m_remaining != 0, "Dereferenced end of TileKindSet" );
+	return TileKindIndex{ static_cast< size_t >( std::countr_zero( m_remaining ) ) }.Kind();
+}
+
+//------------------------------------------------------------------------------
+inline void TileKindSet::Insert
+(
+	TileKindIndex i_kind
+)
+{
+	m_mask |= uint64_t{ 1 } << i_kind;
+}
+
+//------------------------------------------------------------------------------
+inline void TileKindSet::Erase
+(
+	TileKindIndex i_kind
+)
+{
+	m_mask &= ~( uint64_t{ 1 } << i_kind );
+}
+
+//------------------------------------------------------------------------------
+inline bool TileKindSet::Contains
+(
+	TileKindIndex i_kind
+)	const
+{
+	return ( m_mask & ( uint64_t{ 1 } << i_kind ) ) != 0;
+}
+
+//------------------------------------------------------------------------------
+inline size_t TileKindSet::Size
+(
+)	const
+{
+	return static_cast< size_t >( std::popcount( m_mask ) );
+}
+
+}
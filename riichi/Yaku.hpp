@@ -2,8 +2,16 @@
 
 #include "Containers.hpp"
 #include "Declare.hpp"
+#include "Hand.hpp"
+#include "HandInterpreter.hpp"
+#include "IDs.hpp"
 #include "Tile.hpp"
 
+#include <bitset>
+#include <numeric>
+#include <ranges>
+#include <tuple>
+
 namespace Riichi
 {
 
@@ -37,14 +45,62 @@ public:
 	Han Get() const { return m_value.value(); }
 };
 
+//------------------------------------------------------------------------------
+// Given out by the rules on registration, in the order yaku are added
+using YakuID = TypeSafeID<struct YakuIDTag, uint8_t>;
+
+//------------------------------------------------------------------------------
+// The yaku making up a score and what each is worth, as a bitset of YakuIDs alongside their han.
+// Fixed-size, so scores are cheap to copy and compare. Names are only needed for display, so come from the rules.
+//------------------------------------------------------------------------------
+class YakuValues
+{
+public:
+	static constexpr size_t c_maxYaku = 64;
+
+private:
+	std::bitset<c_maxYaku> m_yaku;
+	Array<Han, c_maxYaku> m_han{};
+
+public:
+	YakuValues() = default;
+	YakuValues( std::initializer_list<Pair<YakuID, HanValue>> i_values ) { for ( auto const& [ yaku, value ] : i_values ) { Add( yaku, value ); } }
+
+	void Add( YakuID i_yaku, HanValue i_value )
+	{
+		riEnsure( i_value.IsValid() && !Contains( i_yaku ), "Yaku must be valid and only added once" );
+		m_yaku.set( i_yaku.GetValue() );
+		m_han[ i_yaku.GetValue() ] = i_value.Get();
+	}
+	void Clear() { m_yaku.reset(); m_han.fill( 0 ); }
+
+	bool Contains( YakuID i_yaku ) const { return m_yaku.test( i_yaku.GetValue() ); }
+	HanValue Value( YakuID i_yaku ) const { return Contains( i_yaku ) ? HanValue{ m_han[ i_yaku.GetValue() ] } : HanValue{ NoYaku }; }
+	size_t Size() const { return m_yaku.count(); }
+	bool Empty() const { return m_yaku.none(); }
+	Han HanTotal() const { return std::accumulate( m_han.begin(), m_han.end(), Han{ 0 } ); }
+
+	// Yaku in ID order, which is the order they were registered
+	inline auto IDs() const
+	{
+		return std::views::iota( size_t{ 0 }, c_maxYaku )
+			| std::views::filter( [ this ]( size_t i_yakuI ) { return m_yaku.test( i_yakuI ); } )
+			| std::views::transform( []( size_t i_yakuI ) { return YakuID{ static_cast< YakuID::CoreType >( i_yakuI ) }; } );
+	}
+
+	bool operator==( YakuValues const& i_other ) const = default;
+};
+
 //------------------------------------------------------------------------------
 struct YakuEvaluator
 {
 	virtual ~YakuEvaluator() = default;
 
 	virtual char const* Name() const = 0;
+	YakuID ID() const { return m_id; }
 	virtual char const* InterpreterName() const = 0;
-	bool UsesInterpreter( char const* i_interp ) const { /*TODO-OPT*/return std::strcmp(InterpreterName(), i_interp) == 0; }
+	// Only checked when registering with the rules, which then keep a list of evaluators per interpreter
+	bool UsesInterpreter( char const* i_interp ) const { return std::strcmp( InterpreterName(), i_interp ) == 0; }
 
 	// NB do not need to check whether i_lastTile is in the interp's waits - it will be
 	virtual HanValue CalculateValue
@@ -61,6 +117,14 @@ struct YakuEvaluator
 	// Would this yaku be valid if we riichi'd? This will determine if riichi can be done or not
 	// A little bit of a bodge but saves having to do hand assessments more than once
 	virtual bool AddsYakuToRiichi() const { return false; }
+
+	// The most CalculateValue can ever give, so that scoring can stop on interpretations that can't win.
+	// Defaults to yakuman, which is always safe but never lets anything be skipped.
+	virtual HanValue MaxValue() const { return Yakuman; }
+
+private:
+	friend struct Rules;
+	YakuID m_id;
 };
 
 //------------------------------------------------------------------------------
@@ -114,4 +178,53 @@ private:
 
 #define DECLARE_YAKU( NAME, INTERPRETER ) BEGIN_YAKU( NAME, INTERPRETER ) END_YAKU()
 
+//------------------------------------------------------------------------------
+// A ruleset's yaku given as a list of types, for rulesets that know them all up front.
+// Evaluating through the list calls each yaku directly rather than through the vtable,
+// so instantiating it next to the yaku definitions lets the whole loop be inlined.
+// Register the list with Rules::AddYakuList so the runtime evaluators stay in step with it.
+//------------------------------------------------------------------------------
+template<std::derived_from<YakuEvaluator>... T_Yaku>
+class YakuList
+{
+public:
+	static constexpr size_t c_count = sizeof...( T_Yaku );
+
+	YakuList();
+
+	// The ID the rules gave a yaku of the list
+	template<typename T_Target>
+	YakuID ID() const;
+
+	// Scores an interpretation with every yaku of its interpreter, yakuman first, adding the valid ones to o_values.
+	// Gives up and returns false as soon as the total can no longer reach i_target.
+	bool Evaluate
+	(
+		Han i_target,
+		Han& o_total,
+		YakuValues& o_values,
+		YAKU_CALCULATEVALUE_PARAMS()
+	) const;
+
+	// Whether any yaku of the interpretation's interpreter is valid, stopping at the first
+	bool AnyValid
+	(
+		YAKU_CALCULATEVALUE_PARAMS()
+	) const;
+
+	// Matches each yaku up with the interpreter it scores and the ID it was given, done once by the rules on registration
+	template<typename T_Interpreters>
+	void Link( T_Interpreters const& i_interpreters, YakuID i_firstID );
+
+private:
+	std::tuple<T_Yaku...> m_yaku;
+	YakuID m_firstID;
+	Array<Han, c_count> m_maxValues;
+	Array<bool, c_count> m_yakuman;
+	size_t m_maxTotal{ 0 };
+	Array<InterpreterID, c_count> m_interpreters{};
+};
+
 }
+
+#include "Yaku.inl"
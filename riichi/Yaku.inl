@@ -0,0 +1,159 @@
+#pragma once
+
+#include "Yaku.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Riichi
+{
+
+//------------------------------------------------------------------------------
+template<std::derived_from<YakuEvaluator>... T_Yaku>
+YakuList<T_Yaku...>::YakuList
+(
+)
+{
+	std::apply(
+		[ this ]( T_Yaku const&... i_yaku )
+		{
+			// Yaku tend to override MaxValue privately, so ask through the base
+			m_yakuman = { static_cast< YakuEvaluator const& >( i_yaku ).MaxValue().IsYakuman()... };
+			m_maxValues = { static_cast< YakuEvaluator const& >( i_yaku ).MaxValue().Get()... };
+		},
+		m_yaku
+	);
+
+	for ( Han maxValue : m_maxValues )
+	{
+		m_maxTotal += maxValue;
+	}
+}
+
+//------------------------------------------------------------------------------
+template<std::derived_from<YakuEvaluator>... T_Yaku>
+template<typename T_Target>
+YakuID YakuList<T_Yaku...>::ID
+(
+)	const
+{
+	constexpr size_t c_index = []()
+	{
+		Array<bool, c_count> const matches{ std::is_same_v<T_Target, T_Yaku>... };
+		return static_cast< size_t >( std::ranges::find( matches, true ) - matches.begin() );
+	}();
+	static_assert( c_index < c_count, "Yaku isn't in the list" );
+
+	riEnsure( m_firstID.IsValid(), "Yaku list hasn't been registered" );
+	return YakuID{ static_cast< YakuID::CoreType >( m_firstID.GetValue() + c_index ) };
+}
+
+//------------------------------------------------------------------------------
+template<std::derived_from<YakuEvaluator>... T_Yaku>
+bool YakuList<T_Yaku...>::Evaluate
+(
+	Han i_target,
+	Han& o_total,
+	YakuValues& o_values,
+	YAKU_CALCULATEVALUE_PARAMS()
+)	const
+{
+	Han total = 0;
+	size_t maxRemaining = m_maxTotal;
+
+	// Every yaku counts towards the bound until it's been passed, even if it's for another interpreter, which keeps the bound cheap and still safe
+	auto fnTryYaku = [ & ]( auto const& i_yaku, size_t i_index )
+	{
+		if ( total + maxRemaining < i_target )
+		{
+			return false;
+		}
+		maxRemaining -= m_maxValues[ i_index ];
+
+		if ( m_interpreters[ i_index ] == i_interp.m_interpreter )
+		{
+			// Each yaku's CalculateValue is final, so this is a direct call
+			HanValue const value = i_yaku.CalculateValue(
+				i_round,
+				i_playerSeat,
+				i_hand,
+				i_assessment,
+				i_interp,
+				i_lastTile,
+				i_lastTileDrawType
+			);
+
+			if ( value.IsValid() )
+			{
+				o_values.Add( YakuID{ static_cast< YakuID::CoreType >( m_firstID.GetValue() + i_index ) }, value );
+				total += value.Get();
+			}
+		}
+		return true;
+	};
+
+	bool const finished = [ & ]<size_t... t_Is>( std::index_sequence<t_Is...> )
+	{
+		// Yakuman first, so that once one is found every interpretation without one is given up on quickly
+		return ( ( !m_yakuman[ t_Is ] || fnTryYaku( std::get<t_Is>( m_yaku ), t_Is ) ) && ... )
+			&& ( ( m_yakuman[ t_Is ] || fnTryYaku( std::get<t_Is>( m_yaku ), t_Is ) ) && ... );
+	}( std::index_sequence_for<T_Yaku...>{} );
+
+	o_total = total;
+	return finished;
+}
+
+//------------------------------------------------------------------------------
+template<std::derived_from<YakuEvaluator>... T_Yaku>
+bool YakuList<T_Yaku...>::AnyValid
+(
+	YAKU_CALCULATEVALUE_PARAMS()
+)	const
+{
+	return [ & ]<size_t... t_Is>( std::index_sequence<t_Is...> )
+	{
+		return ( ( m_interpreters[ t_Is ] == i_interp.m_interpreter
+			&& std::get<t_Is>( m_yaku ).CalculateValue(
+				i_round,
+				i_playerSeat,
+				i_hand,
+				i_assessment,
+				i_interp,
+				i_lastTile,
+				i_lastTileDrawType
+			).IsValid() ) || ... );
+	}( std::index_sequence_for<T_Yaku...>{} );
+}
+
+//------------------------------------------------------------------------------
+template<std::derived_from<YakuEvaluator>... T_Yaku>
+template<typename T_Interpreters>
+void YakuList<T_Yaku...>::Link
+(
+	T_Interpreters const& i_interpreters,
+	YakuID i_firstID
+)
+{
+	m_firstID = i_firstID;
+
+	std::apply(
+		[ & ]( T_Yaku const&... i_yaku )
+		{
+			size_t yakuI = 0;
+			( [ & ]( YakuEvaluator const& i_evaluator )
+			{
+				for ( HandInterpreter const& interpreter : i_interpreters )
+				{
+					if ( i_evaluator.UsesInterpreter( interpreter.Name() ) )
+					{
+						m_interpreters[ yakuI ] = interpreter.ID();
+					}
+				}
+				++yakuI;
+			}( i_yaku ), ... );
+		},
+		m_yaku
+	);
+}
+
+}
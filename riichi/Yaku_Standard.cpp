@@ -12,6 +12,31 @@ namespace Riichi::StandardYaku
 // TODO-DEBT: Lots of the yaku need to assess the 'final group' separately from the rest of the groups. This is to avoid creating a container and doing a bunch of copies where unnecessary
 // It would be nice to clean this up somehow. It would also be nice if all the yaku could be made to avoid allocating entirely when assessing!
 
+//------------------------------------------------------------------------------
+// The number tiles of one suit, in a mask of TileKindIndex bits
+static constexpr uint64_t c_oneSuitMask = ( uint64_t{ 1 } << Numbers::Count() ) - 1;
+
+//------------------------------------------------------------------------------
+// Bit for the start of the sequence the last tile completes, to combine with HandFeatures::m_sequenceStarts
+static uint64_t FinalSequenceStart
+(
+	HandInterpretation const& i_interp,
+	Tile const& i_lastTile
+)
+{
+	if ( !SequenceWait( i_interp.m_waitType ) )
+	{
+		return 0;
+	}
+
+	size_t lowestKind = TileKindIndex{ i_lastTile };
+	for ( Tile const& tile : i_interp.m_ungrouped )
+	{
+		lowestKind = std::min< size_t >( lowestKind, TileKindIndex{ tile } );
+	}
+	return uint64_t{ 1 } << lowestKind;
+}
+
 //------------------------------------------------------------------------------
 HanValue MenzenchinTsumohou::CalculateValue
 (
@@ -117,46 +142,18 @@ HanValue Iipeikou::CalculateValue
 		return NoYaku;
 	}
 
-	// TODO-OPT: I wonder if there's a more efficient way of assessing this than just comparing all groups
-
-	if ( SequenceWait( i_interp.m_waitType ) )
-	{
-		// Need to consider the final group, as it completed a sequence
-		HandGroup const finalGroup( i_interp, i_lastTile );
-
-		for ( HandGroup const& group : i_interp.m_groups )
-		{
-			if ( IsMatchingSequence( finalGroup, group ) )
-			{
-				return 1;
-			}
-		}
-	}
-
-	for ( size_t groupI = 0; groupI < i_interp.m_groups.size(); ++groupI )
+	// Either two sequences already match, or the final group matches one of them
+	HandFeatures const& features = i_interp.m_features;
+	if ( features.m_repeatedSequenceStarts != 0
+		|| ( features.m_sequenceStarts & FinalSequenceStart( i_interp, i_lastTile ) ) != 0 )
 	{
-		for ( size_t secondGroupI = groupI + 1; secondGroupI < i_interp.m_groups.size(); ++secondGroupI )
-		{
-			if ( IsMatchingSequence( i_interp.m_groups[ groupI ], i_interp.m_groups[ secondGroupI ] ) )
-			{
-				return 1;
-			}
-		}
+		return 1;
 	}
 
 	// Failed to find matches
 	return NoYaku;
 }
 
-/*static*/ bool Iipeikou::IsMatchingSequence( HandGroup const& i_a, HandGroup const& i_b )
-{
-	if ( i_a.Type() == GroupType::Sequence && i_b.Type() == GroupType::Sequence )
-	{
-		return std::ranges::equal( i_a.Tiles(), i_b.Tiles(), EqualsTileKindOp{} );
-	}
-	return false;
-}
-
 //------------------------------------------------------------------------------
 HanValue HaiteiRaoyue::CalculateValue
 (
@@ -291,17 +288,14 @@ HanValue Chantaiyao::CalculateValue
 	YAKU_CALCULATEVALUE_PARAMS()
 )	const
 {
-	for ( HandGroup const& group : i_interp.m_groups )
+	HandFeatures const& features = i_interp.m_features;
+	if ( !features.m_groupsAllHaveHonourOrTerminal )
 	{
-		if ( !std::ranges::any_of( group.Tiles(), RequiredTile ) )
-		{
-			return NoYaku;
-		}
+		return NoYaku;
 	}
 
 	// Check final group too
-	if ( !RequiredTile( i_lastTile )
-		&& !std::ranges::any_of( i_interp.m_ungrouped, RequiredTile ) )
+	if ( !i_lastTile.IsHonourOrTerminal() && !features.m_ungroupedHasHonourOrTerminal )
 	{
 		return NoYaku;
 	}
@@ -309,138 +303,46 @@ HanValue Chantaiyao::CalculateValue
 	return i_assessment.m_open ? 1 : 2;
 }
 
-/*static*/ bool Chantaiyao::RequiredTile( Tile const& i_tile )
-{
-	return i_tile.IsHonourOrTerminal();
-}
-
 //------------------------------------------------------------------------------
 HanValue SanshokuDoujun::CalculateValue
 (
 	YAKU_CALCULATEVALUE_PARAMS()
 )	const
 {
-	// Note 1: Unfortunately, the fourth group and pair are totally unrelated, so we can't make quick rule-outs without checking all combos
-	// Note 2: We can also stop when we find a match or when we are sure we don't have a match, so it's not too bad of a search at least.
-
 	if ( !i_assessment.HasNumbersOfAllSuits() )
 	{
 		return NoYaku;
 	}
 
-	// TODO-OPT: I wonder if there's a more efficient way of assessing this than just comparing all triples of groups
-
-	if ( SequenceWait( i_interp.m_waitType ) )
+	// Line the suits' sequence starts up on top of each other, and look for a face that all three share
+	uint64_t const starts = i_interp.m_features.m_sequenceStarts | FinalSequenceStart( i_interp, i_lastTile );
+	if ( ( starts & ( starts >> Numbers::Count() ) & ( starts >> ( Numbers::Count() * 2 ) ) & c_oneSuitMask ) != 0 )
 	{
-		// Need to consider the final group, as it completed a sequence
-		HandGroup const finalGroup( i_interp, i_lastTile );
-
-		for ( size_t groupI = 0; groupI < i_interp.m_groups.size(); ++groupI )
-		{
-			for ( size_t secondGroupI = groupI + 1; secondGroupI < i_interp.m_groups.size(); ++secondGroupI )
-			{
-				if ( Sanshoku( finalGroup, i_interp.m_groups[ groupI ], i_interp.m_groups[ secondGroupI ] ) )
-				{
-					return i_assessment.m_open ? 1 : 2;
-				}
-			}
-		}
-	}
-
-	// Didn't find one with final group, so check the existing groups
-	for ( size_t groupI = 0; groupI < i_interp.m_groups.size(); ++groupI )
-	{
-		for ( size_t secondGroupI = groupI + 1; secondGroupI < i_interp.m_groups.size(); ++secondGroupI )
-		{
-			for ( size_t thirdGroupI = secondGroupI + 1; thirdGroupI < i_interp.m_groups.size(); ++thirdGroupI )
-			{
-				if ( Sanshoku( i_interp.m_groups[ groupI ], i_interp.m_groups[ secondGroupI ], i_interp.m_groups[ thirdGroupI ] ) )
-				{
-					return i_assessment.m_open ? 1 : 2;
-				}
-			}
-		}
+		return i_assessment.m_open ? 1 : 2;
 	}
 
 	// Failed to find matches
 	return NoYaku;
 }
 
-/*static*/ bool SanshokuDoujun::Sanshoku( HandGroup const& i_a, HandGroup const& i_b, HandGroup const& i_c )
-{
-	if ( i_a.Type() != GroupType::Sequence || i_b.Type() != GroupType::Sequence || i_c.Type() != GroupType::Sequence )
-	{
-		return false;
-	}
-
-	if ( i_a.CommonSuit() == i_b.CommonSuit() || i_b.CommonSuit() == i_c.CommonSuit() || i_a.CommonSuit() == i_c.CommonSuit() )
-	{
-		return false;
-	}
-
-	return std::ranges::all_of(
-		std::views::zip( i_a.Tiles(), i_b.Tiles(), i_c.Tiles() ),
-		[]( auto const& i_tileSet )
-		{
-			auto const& [tileA, tileB, tileC] = i_tileSet;
-			return tileA.Face() == tileB.Face()
-				&& tileB.Face() == tileC.Face();
-		}
-	);
-}
-
 //------------------------------------------------------------------------------
 HanValue Ikkitsuukan::CalculateValue
 (
 	YAKU_CALCULATEVALUE_PARAMS()
 )	const
 {
-	// This one isn't so bad. We'll make a matrix of suit x sequence and just search for all the groups we need
-
-	static constexpr Array<Face, 3> c_requiredSequenceStarts
-	{
-		Face::One,
-		Face::Four,
-		Face::Seven,
-	};
-
-	Utils::EnumArray<Array<bool, 3>, Suits> groupsPerSuit{};
+	// Sequences starting on 1, 4 and 7 of any one suit
+	static constexpr uint64_t c_requiredSequenceStarts = ( uint64_t{ 1 } << Numbers::ValueToIndex( Face::One ) )
+		| ( uint64_t{ 1 } << Numbers::ValueToIndex( Face::Four ) )
+		| ( uint64_t{ 1 } << Numbers::ValueToIndex( Face::Seven ) );
 
-	auto fnEvalGroup = [ &groupsPerSuit ]( HandGroup const& i_group )
+	uint64_t const starts = i_interp.m_features.m_sequenceStarts | FinalSequenceStart( i_interp, i_lastTile );
+	for ( size_t suitI = 0; suitI < Suits::Count(); ++suitI )
 	{
-		if ( i_group.Type() != GroupType::Sequence )
+		if ( ( ( starts >> ( suitI * Numbers::Count() ) ) & c_requiredSequenceStarts ) == c_requiredSequenceStarts )
 		{
-			return;
-		}
-
-		for ( size_t i = 0; i < 3; ++i )
-		{
-			if ( i_group[ 0 ].Face() == c_requiredSequenceStarts[i] )
-			{
-				riEnsure( i_group[ 1 ].Prev().Face() == c_requiredSequenceStarts[i], "Invalid sequence provided");
-				riEnsure( i_group[ 2 ].Prev().Prev().Face() == c_requiredSequenceStarts[i], "Invalid sequence provided");
-				groupsPerSuit[ i_group.CommonSuit() ][ i ] = true;
-				break;
-			}
+			return i_assessment.m_open ? 1 : 2;
 		}
-	};
-
-	if ( SequenceWait( i_interp.m_waitType ) )
-	{
-		// Need to consider the final group, as it completed a sequence
-		HandGroup const finalGroup( i_interp, i_lastTile );
-
-		fnEvalGroup( finalGroup );
-	}
-
-	for ( HandGroup const& group : i_interp.m_groups )
-	{
-		fnEvalGroup( group );
-	}
-
-	if ( std::ranges::any_of( groupsPerSuit, []( auto const& arr ) { return std::ranges::all_of( arr, std::identity{} ); } ) )
-	{
-		return i_assessment.m_open ? 1 : 2;
 	}
 
 	// Failed to find ittsuu
@@ -453,18 +355,9 @@ HanValue Toitoi::CalculateValue
 	YAKU_CALCULATEVALUE_PARAMS()
 )	const
 {
-	for ( HandGroup const& group : i_interp.m_groups )
-	{
-		if ( group.Type() == GroupType::Sequence )
-		{
-			return NoYaku;
-		}
-	}
-
 	// Check if we're completing a sequence too
-	if ( SequenceWait( i_interp.m_waitType ) )
+	if ( i_interp.m_features.m_sequenceCount > 0 || SequenceWait( i_interp.m_waitType ) )
 	{
-		// Sequence wait
 		return NoYaku;
 	}
 
@@ -477,14 +370,7 @@ HanValue Sanankou::CalculateValue
 	YAKU_CALCULATEVALUE_PARAMS()
 )	const
 {
-	int concealedTripleCount = 0;
-	for ( HandGroup const& group : i_interp.m_groups )
-	{
-		if ( !group.Open() && ConsiderLikeTriplet( group.Type() ) )
-		{
-			++concealedTripleCount;
-		}
-	}
+	int concealedTripleCount = i_interp.m_features.m_concealedTripletCount;
 
 	// Check if we're completing a closed triplet too
 	if ( i_lastTileDrawType != TileDrawType::DiscardDraw && i_interp.m_waitType == WaitType::Shanpon )
@@ -605,10 +491,10 @@ HanValue Chiitoitsu::CalculateValue
 		return NoYaku;
 	}
 
-	// TODO-OPT: Can we do this without filling a container?
-
-	Set<TileKind> uniqueTiles;
-	uniqueTiles.insert( i_lastTile );
+	// Each pair must be of a different kind, and the waiting tile must make a new one
+	Array<bool, TileKindIndex::c_count> seenKinds{};
+	seenKinds[ TileKindIndex{ i_lastTile } ] = true;
+	size_t uniqueCount = 1;
 
 	for ( HandGroup const& group : i_interp.m_groups )
 	{
@@ -616,10 +502,12 @@ HanValue Chiitoitsu::CalculateValue
 		{
 			return NoYaku;
 		}
-		uniqueTiles.insert( group[ 0 ] );
+		bool& seen = seenKinds[ TileKindIndex{ group[ 0 ] } ];
+		uniqueCount += seen ? 0 : 1;
+		seen = true;
 	}
 
-	if ( uniqueTiles.size() == 7 )
+	if ( uniqueCount == 7 )
 	{
 		return 2;
 	}
@@ -740,17 +628,14 @@ HanValue JunchanTaiyao::CalculateValue
 		return NoYaku;
 	}
 
-	for ( HandGroup const& group : i_interp.m_groups )
+	HandFeatures const& features = i_interp.m_features;
+	if ( !features.m_groupsAllHaveTerminal )
 	{
-		if ( !std::ranges::any_of( group.Tiles(), RequiredTile ) )
-		{
-			return NoYaku;
-		}
+		return NoYaku;
 	}
 
 	// Check final group too
-	if ( !RequiredTile( i_lastTile )
-		&& !std::ranges::any_of( i_interp.m_ungrouped, RequiredTile ) )
+	if ( !i_lastTile.IsTerminal() && !features.m_ungroupedHasTerminal )
 	{
 		return NoYaku;
 	}
@@ -758,11 +643,6 @@ HanValue JunchanTaiyao::CalculateValue
 	return i_assessment.m_open ? 2 : 3;
 }
 
-/*static*/ bool JunchanTaiyao::RequiredTile( Tile const& i_tile )
-{
-	return i_tile.IsTerminal();
-}
-
 //------------------------------------------------------------------------------
 HanValue Ryanpeikou::CalculateValue
 (
@@ -879,41 +759,30 @@ HanValue KokushiMusou::CalculateValue
 		return NoYaku;
 	}
 
-	// TODO-OPT: Can we do this without filling a container?
-
 	// Sufficient to check that all tiles are terminals/honours and that the distinct tile count >= 13
-	Set<TileKind> uniqueTiles;
-	uniqueTiles.reserve( 14 );
-
-	for ( HandGroup const& group : i_interp.m_groups )
+	if ( !i_lastTile.IsHonourOrTerminal() )
 	{
-		for ( Tile const& tile : group.Tiles() )
-		{
-			if ( !tile.IsHonourOrTerminal() )
-			{
-				return NoYaku;
-			}
-			uniqueTiles.insert( tile );
-		}
+		return NoYaku;
 	}
 
-	for ( Tile const& tile : i_interp.m_ungrouped )
+	TileCounts counts = i_assessment.AllTileCounts();
+	counts.Add( i_lastTile );
+
+	size_t uniqueCount = 0;
+	for ( size_t kindI = 0; kindI < TileKindIndex::c_count; ++kindI )
 	{
-		if ( !tile.IsHonourOrTerminal() )
+		if ( counts[ kindI ] == 0 )
+		{
+			continue;
+		}
+		if ( !TileKindIndex{ kindI }.IsHonourOrTerminal() )
 		{
 			return NoYaku;
 		}
-		uniqueTiles.insert( tile );
-	}
-
-	// And finally the big tile itself
-	if ( !i_lastTile.IsHonourOrTerminal() )
-	{
-		return NoYaku;
+		++uniqueCount;
 	}
-	uniqueTiles.insert( i_lastTile );
 
-	if ( uniqueTiles.size() >= 13 )
+	if ( uniqueCount >= 13 )
 	{
 		return Yakuman;
 	}
@@ -927,14 +796,7 @@ HanValue Suuankou::CalculateValue
 	YAKU_CALCULATEVALUE_PARAMS()
 )	const
 {
-	int concealedTripleCount = 0;
-	for ( HandGroup const& group : i_interp.m_groups )
-	{
-		if ( !group.Open() && ConsiderLikeTriplet( group.Type() ) )
-		{
-			++concealedTripleCount;
-		}
-	}
+	int concealedTripleCount = i_interp.m_features.m_concealedTripletCount;
 
 	// Check if we're completing a closed triplet too
 	if ( i_lastTileDrawType != TileDrawType::DiscardDraw && i_interp.m_waitType == WaitType::Shanpon )
@@ -1187,38 +1049,26 @@ HanValue ChuurenPoutou::CalculateValue
 		1, 1, 3,
 	};
 
-	auto fnEvalTile = [ requiredSuit, &requiredOfEachValue ]( Tile const& i_tile )
-	{
-		if ( i_tile.Suit() != requiredSuit )
-		{
-			return false;
-		}
-		--requiredOfEachValue[ i_tile.Face()];
-		return true;
-	};
+	TileCounts counts = i_assessment.AllTileCounts();
+	counts.Add( i_lastTile );
 
-	for ( HandGroup const& group : i_interp.m_groups )
+	for ( Suit suit : Suits{} )
 	{
-		for ( Tile const& tile : group.Tiles() )
+		for ( Face face : Numbers{} )
 		{
-			if ( !fnEvalTile( tile ) )
+			uint8_t const count = counts[ TileKind{ suit, face } ];
+			if ( suit != requiredSuit )
 			{
-				return NoYaku;
+				if ( count > 0 )
+				{
+					return NoYaku;
+				}
+				continue;
 			}
+			requiredOfEachValue[ face ] -= count;
 		}
 	}
 
-	for ( Tile const& tile : i_interp.m_ungrouped )
-	{
-		if ( !fnEvalTile( tile ) )
-		{
-			return NoYaku;
-		}
-	}
-
-	// And finally the big tile itself
-	fnEvalTile( i_lastTile );
-
 	// If every value is 0 or less (technically, there should be exactly one value with -1, the others all 0)
 	// then we have the yakuman
 	if ( std::ranges::all_of( requiredOfEachValue, []( int n ) { return n <= 0; } ) )
@@ -1286,4 +1136,25 @@ HanValue Chihou::CalculateValue
 	return NoYaku;
 }
 
+//------------------------------------------------------------------------------
+bool List::Evaluate
+(
+	Han i_target,
+	Han& o_total,
+	YakuValues& o_values,
+	YAKU_CALCULATEVALUE_PARAMS()
+)	const
+{
+	return YakuList::Evaluate( i_target, o_total, o_values, i_round, i_playerSeat, i_hand, i_assessment, i_interp, i_lastTile, i_lastTileDrawType );
+}
+
+//------------------------------------------------------------------------------
+bool List::AnyValid
+(
+	YAKU_CALCULATEVALUE_PARAMS()
+)	const
+{
+	return YakuList::AnyValid( i_round, i_playerSeat, i_hand, i_assessment, i_interp, i_lastTile, i_lastTileDrawType );
+}
+
 }
@@ -11,58 +11,73 @@ namespace Riichi::StandardYaku
 //------------------------------------------------------------------------------
 // Win by self-draw with closed hand
 //------------------------------------------------------------------------------
-DECLARE_YAKU( MenzenchinTsumohou, Standard );
+BEGIN_YAKU( MenzenchinTsumohou, Standard )
+	HanValue MaxValue() const override { return 1; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // Win after calling riichi
 //------------------------------------------------------------------------------
 BEGIN_YAKU( Riichi, Standard )
+	HanValue MaxValue() const override { return 1; }
 	bool AddsYakuToRiichi() const override { return true; }
 END_YAKU();
 
 //------------------------------------------------------------------------------
 // Win after calling riichi before your next discard and before any calls
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Ippatsu, Standard );
+BEGIN_YAKU( Ippatsu, Standard )
+	HanValue MaxValue() const override { return 1; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // Win on a ryanmen wait with a closed hand and no fu
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Pinfu, Standard );
+BEGIN_YAKU( Pinfu, Standard )
+	HanValue MaxValue() const override { return 1; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // Closed hand containing two identical sequences
 //------------------------------------------------------------------------------
 BEGIN_YAKU( Iipeikou, Standard )
-	static bool IsMatchingSequence( HandGroup const& i_a, HandGroup const& i_b );
+	HanValue MaxValue() const override { return 1; }
 END_YAKU();
 
 //------------------------------------------------------------------------------
 // Win with tsumo on final tile from the wall
 //------------------------------------------------------------------------------
-DECLARE_YAKU( HaiteiRaoyue, Standard );
+BEGIN_YAKU( HaiteiRaoyue, Standard )
+	HanValue MaxValue() const override { return 1; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // Win with ron on final discard
 //------------------------------------------------------------------------------
-DECLARE_YAKU( HouteiRaoyui, Standard );
+BEGIN_YAKU( HouteiRaoyui, Standard )
+	HanValue MaxValue() const override { return 1; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // Win on dead wall draw
 //------------------------------------------------------------------------------
-DECLARE_YAKU( RinshanKaihou, Standard );
+BEGIN_YAKU( RinshanKaihou, Standard )
+	HanValue MaxValue() const override { return 1; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // Win on an upgraded kan tile
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Chankan, Standard );
+BEGIN_YAKU( Chankan, Standard )
+	HanValue MaxValue() const override { return 1; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // Only 2-8 tiles in hand
 //------------------------------------------------------------------------------
 template<bool t_KuitanEnabled = true>
 BEGIN_YAKU( Tanyao, Standard )
-	static bool InvalidTile( Tile const& i_tile );
+	HanValue MaxValue() const override { return 1; }
 END_YAKU();
 
 //------------------------------------------------------------------------------
@@ -79,6 +94,8 @@ struct DragonYakuhai
 		YAKU_CALCULATEVALUE_PARAMS()
 	) const final;
 
+	HanValue MaxValue() const override { return 1; }
+
 private:
 	static bool ValidTile( Tile const& i_tile );
 };
@@ -108,6 +125,7 @@ struct Yakuhai_Chun
 // Need a triple of the round wind
 //------------------------------------------------------------------------------
 BEGIN_YAKU( Bakaze, Standard )
+	HanValue MaxValue() const override { return 1; }
 	static bool ValidTile( Tile const& i_tile, Seat const& i_roundWind );
 END_YAKU();
 
@@ -115,6 +133,7 @@ END_YAKU();
 // Need a triple of the seat wind
 //------------------------------------------------------------------------------
 BEGIN_YAKU( Jikaze, Standard )
+	HanValue MaxValue() const override { return 1; }
 	static bool ValidTile( Tile const& i_tile, Seat const& i_playerSeat );
 END_YAKU();
 
@@ -122,6 +141,7 @@ END_YAKU();
 // Win after calling riichi on the very first discard
 //------------------------------------------------------------------------------
 BEGIN_YAKU( DoubleRiichi, Standard )
+	HanValue MaxValue() const override { return 2; }
 	bool AddsYakuToRiichi() const override { return true; }
 END_YAKU();
 
@@ -129,7 +149,7 @@ END_YAKU();
 // All groups must contain a terminal or honour
 //------------------------------------------------------------------------------
 BEGIN_YAKU( Chantaiyao, Standard )
-	static bool RequiredTile( Tile const& i_tile );
+	HanValue MaxValue() const override { return 2; }
 END_YAKU();
 
 //------------------------------------------------------------------------------
@@ -137,7 +157,7 @@ END_YAKU();
 // Openness affects value
 //------------------------------------------------------------------------------
 BEGIN_YAKU( SanshokuDoujun, Standard )
-	static bool Sanshoku( HandGroup const& i_a, HandGroup const& i_b, HandGroup const& i_c );
+	HanValue MaxValue() const override { return 2; }
 END_YAKU();
 
 //------------------------------------------------------------------------------
@@ -145,40 +165,52 @@ END_YAKU();
 // One suit, three sequences, 123 456 789
 // Openness affects value
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Ikkitsuukan, Standard );
+BEGIN_YAKU( Ikkitsuukan, Standard )
+	HanValue MaxValue() const override { return 2; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // All non-pair groups must be triplets/quads
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Toitoi, Standard );
+BEGIN_YAKU( Toitoi, Standard )
+	HanValue MaxValue() const override { return 2; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // Any 3 concealed triplets or quads in hand
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Sanankou, Standard );
+BEGIN_YAKU( Sanankou, Standard )
+	HanValue MaxValue() const override { return 2; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // Three triplets with the same number but different suits.
 //------------------------------------------------------------------------------
 BEGIN_YAKU( SanshokuDoukou, Standard )
+	HanValue MaxValue() const override { return 2; }
 	static bool Sanshoku( HandGroup const& i_a, HandGroup const& i_b, HandGroup const& i_c );
 END_YAKU();
 
 //------------------------------------------------------------------------------
 // Any 3 quads in hand
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Sankantsu, Standard );
+BEGIN_YAKU( Sankantsu, Standard )
+	HanValue MaxValue() const override { return 2; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // Hand consists of 7 unique pairs
 // Must be closed, by nature of the hand structure
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Chiitoitsu, SevenPairs );
+BEGIN_YAKU( Chiitoitsu, SevenPairs )
+	HanValue MaxValue() const override { return 2; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // All tiles are terminals or honours
 //------------------------------------------------------------------------------
 BEGIN_YAKU( Honroutou, Standard )
+	HanValue MaxValue() const override { return 2; }
 	static bool ValidTile( Tile const& i_tile );
 END_YAKU();
 
@@ -186,70 +218,90 @@ END_YAKU();
 // smol 3 dragons
 // triplets/quads of 2 dragons required + pair of 3rd dragon
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Shousangen, Standard );
+BEGIN_YAKU( Shousangen, Standard )
+	HanValue MaxValue() const override { return Yakuman; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // All tiles belong to exactly one of the three suits, or are honour tiles
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Honitsu, Standard );
+BEGIN_YAKU( Honitsu, Standard )
+	HanValue MaxValue() const override { return 3; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // All groups must contain a terminal
 //------------------------------------------------------------------------------
 BEGIN_YAKU( JunchanTaiyao, Standard )
-	static bool RequiredTile( Tile const& i_tile );
+	HanValue MaxValue() const override { return 3; }
 END_YAKU();
 
 //------------------------------------------------------------------------------
 // Closed hand containing two sets of two identical sequences
 //------------------------------------------------------------------------------
 BEGIN_YAKU( Ryanpeikou, Standard )
+	HanValue MaxValue() const override { return 3; }
 	static bool IsMatchingSequence( HandGroup const& i_a, HandGroup const& i_b );
 END_YAKU();
 
 //------------------------------------------------------------------------------
 // All tiles belong to exactly one of the three suits
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Chinitsu, Standard );
+BEGIN_YAKU( Chinitsu, Standard )
+	HanValue MaxValue() const override { return 6; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // THIRTEEN ORPHANS
 // 19m19s19p1234567z + any terminal/honor, closed only
 //------------------------------------------------------------------------------
-DECLARE_YAKU( KokushiMusou, ThirteenOrphans );
+BEGIN_YAKU( KokushiMusou, ThirteenOrphans )
+	HanValue MaxValue() const override { return Yakuman; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // Any 4 concealed triplets or quads in hand
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Suuankou, Standard );
+BEGIN_YAKU( Suuankou, Standard )
+	HanValue MaxValue() const override { return Yakuman; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // beeg 3 dragons
 // triplets/quads of all 3 dragons required
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Daisangen, Standard );
+BEGIN_YAKU( Daisangen, Standard )
+	HanValue MaxValue() const override { return Yakuman; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // small 4 winds
 // triplets/quads of 3 winds required + pair of 4th wind
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Shousuushii, Standard );
+BEGIN_YAKU( Shousuushii, Standard )
+	HanValue MaxValue() const override { return Yakuman; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // big 4 winds
 // triplets/quads of all 4 winds required
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Daisuushii, Standard );
+BEGIN_YAKU( Daisuushii, Standard )
+	HanValue MaxValue() const override { return Yakuman; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // all honors
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Tsuuiisou, Standard );
+BEGIN_YAKU( Tsuuiisou, Standard )
+	HanValue MaxValue() const override { return Yakuman; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // all terminals
 //------------------------------------------------------------------------------
 BEGIN_YAKU( Chinroutou, Standard )
+	HanValue MaxValue() const override { return Yakuman; }
 	static bool RequiredTile( Tile const& i_tile );
 END_YAKU();
 
@@ -258,6 +310,7 @@ END_YAKU();
 // 23468s7z only
 //------------------------------------------------------------------------------
 BEGIN_YAKU( Ryuuiisou, Standard )
+	HanValue MaxValue() const override { return Yakuman; }
 	static bool RequiredTile( Tile const& i_tile );
 END_YAKU();
 
@@ -265,25 +318,97 @@ END_YAKU();
 // NINE GATES
 // 1112345678999 + any, in same suit, closed only
 //------------------------------------------------------------------------------
-DECLARE_YAKU( ChuurenPoutou, Standard );
+BEGIN_YAKU( ChuurenPoutou, Standard )
+	HanValue MaxValue() const override { return Yakuman; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // Any 4 quads in hand, can be open or closed
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Suukantsu, Standard );
+BEGIN_YAKU( Suukantsu, Standard )
+	HanValue MaxValue() const override { return Yakuman; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // Win as the dealer on the first tile
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Tenhou, Standard );
+BEGIN_YAKU( Tenhou, Standard )
+	HanValue MaxValue() const override { return Yakuman; }
+END_YAKU();
 
 //------------------------------------------------------------------------------
 // Win as a non-dealer on the first tile drawn
 //------------------------------------------------------------------------------
-DECLARE_YAKU( Chihou, Standard );
+BEGIN_YAKU( Chihou, Standard )
+	HanValue MaxValue() const override { return Yakuman; }
+END_YAKU();
 
 // Kazoe Yakuman left up to game system to use or not
 
+//------------------------------------------------------------------------------
+// Every standard yaku, in the order they're registered and reported.
+// Evaluation is defined alongside the yaku, so it can inline them all.
+//------------------------------------------------------------------------------
+struct List
+	: public YakuList<
+		MenzenchinTsumohou,
+		Riichi,
+		Ippatsu,
+		Pinfu,
+		Iipeikou,
+		HaiteiRaoyue,
+		HouteiRaoyui,
+		RinshanKaihou,
+		Chankan,
+		Tanyao<>,
+		Yakuhai_Haku,
+		Yakuhai_Hatsu,
+		Yakuhai_Chun,
+		Bakaze,
+		Jikaze,
+		DoubleRiichi,
+		Chantaiyao,
+		SanshokuDoujun,
+		Ikkitsuukan,
+		Toitoi,
+		Sanankou,
+		SanshokuDoukou,
+		Sankantsu,
+		Chiitoitsu,
+		Honroutou,
+		Shousangen,
+		Honitsu,
+		JunchanTaiyao,
+		Ryanpeikou,
+		Chinitsu,
+		KokushiMusou,
+		Suuankou,
+		Daisangen,
+		Shousuushii,
+		Daisuushii,
+		Tsuuiisou,
+		Chinroutou,
+		Ryuuiisou,
+		ChuurenPoutou,
+		Suukantsu,
+		Tenhou,
+		Chihou
+	>
+{
+	bool Evaluate
+	(
+		Han i_target,
+		Han& o_total,
+		YakuValues& o_values,
+		YAKU_CALCULATEVALUE_PARAMS()
+	) const;
+
+	bool AnyValid
+	(
+		YAKU_CALCULATEVALUE_PARAMS()
+	) const;
+};
+
 }
 
 #include "Yaku_Standard.inl"
\ No newline at end of file
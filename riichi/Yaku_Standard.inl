@@ -27,31 +27,14 @@ HanValue Tanyao<t_KuitanEnabled>::CalculateValue
 		}
 	}
 
-	if ( InvalidTile( i_lastTile ) || std::ranges::any_of( i_interp.m_ungrouped, InvalidTile ) )
+	if ( !i_interp.m_features.m_allSimples || i_lastTile.IsHonourOrTerminal() )
 	{
 		return NoYaku;
 	}
 
-	for ( HandGroup const& group : i_interp.m_groups )
-	{
-		for ( Tile const& tile : group.Tiles() )
-		{
-			if ( InvalidTile( tile ) )
-			{
-				return NoYaku;
-			}
-		}
-	}
-
 	return 1;
 }
 
-template<bool t_KuitanEnabled>
-/*static*/ bool Tanyao<t_KuitanEnabled>::InvalidTile( Tile const& i_tile )
-{
-	return i_tile.IsHonourOrTerminal();
-}
-
 //------------------------------------------------------------------------------
 template<NameString t_YakuhaiName, Face t_Dragon>
 	requires Dragon<t_Dragon>
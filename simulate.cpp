@@ -0,0 +1,104 @@
+#include "Riichi.hpp"
+
+#include "riichi/AIAgents_Standard.hpp"
+#include "riichi/Rules_Standard.hpp"
+#include "riichi/Simulator.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+//------------------------------------------------------------------------------
+// Headless self-play across every core.
+// Usage: libriichi_simulate [tables] [master seed] [threads] [tonpuusen|hanchan] [agent,agent,agent,agent]
+// Agents are ghost, buttonmasher or efficiency. The summary on stdout is the same whatever the thread count,
+// so runs can be diffed, while timings go to stderr.
+//------------------------------------------------------------------------------
+static std::unique_ptr<Riichi::AI::Agent> MakeAgent
+(
+	std::string_view i_name
+)
+{
+	if ( i_name == "ghost" )
+	{
+		return std::make_unique<Riichi::AI::GhostAgent>();
+	}
+	else if ( i_name == "buttonmasher" )
+	{
+		return std::make_unique<Riichi::AI::ButtonMasherAgent>();
+	}
+	else if ( i_name == "efficiency" )
+	{
+		return std::make_unique<Riichi::AI::EfficiencyAgent>();
+	}
+	return nullptr;
+}
+
+//------------------------------------------------------------------------------
+int main( int argc, char** argv )
+{
+	Riichi::Simulator::Config config;
+	config.m_tableCount = argc > 1 ? std::strtoull( argv[ 1 ], nullptr, 10 ) : 1000;
+	config.m_masterSeed = argc > 2 ? std::strtoull( argv[ 2 ], nullptr, 10 ) : 0;
+	config.m_threadCount = argc > 3 ? std::strtoull( argv[ 3 ], nullptr, 10 ) : 0;
+
+	std::string_view const gameLength = argc > 4 ? argv[ 4 ] : "tonpuusen";
+	if ( gameLength == "hanchan" )
+	{
+		config.m_rules = std::make_shared<Riichi::StandardYonma<Riichi::Seat::South>>();
+	}
+	else if ( gameLength == "tonpuusen" )
+	{
+		config.m_rules = std::make_shared<Riichi::StandardYonma<Riichi::Seat::East>>();
+	}
+	else
+	{
+		std::cerr << "Unknown game length: " << gameLength << std::endl;
+		return 1;
+	}
+
+	Riichi::Vector<std::string> agentNames;
+	std::string_view agents = argc > 5 ? argv[ 5 ] : "ghost,ghost,buttonmasher,buttonmasher";
+	while ( !agents.empty() )
+	{
+		size_t const commaI = agents.find( ',' );
+		agentNames.emplace_back( agents.substr( 0, commaI ) );
+		agents = commaI == std::string_view::npos ? std::string_view{} : agents.substr( commaI + 1 );
+	}
+	for ( std::string const& agentName : agentNames )
+	{
+		if ( !MakeAgent( agentName ) )
+		{
+			std::cerr << "Unknown agent: " << agentName << std::endl;
+			return 1;
+		}
+	}
+	if ( agentNames.size() != 4 )
+	{
+		std::cerr << "Need four agents, got " << agentNames.size() << std::endl;
+		return 1;
+	}
+
+	config.m_makePlayers = [ &agentNames ]( size_t i_tableIndex )
+	{
+		Riichi::Vector<Riichi::Player> players;
+		for ( std::string const& agentName : agentNames )
+		{
+			players.emplace_back( MakeAgent( agentName ) );
+		}
+		return players;
+	};
+
+	Riichi::SimulationSummary summary;
+	std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+	Riichi::Simulator( std::move( config ) ).Run( summary );
+	std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+	summary.Print( std::cout ) << std::endl;
+	std::cerr << "Time: " << elapsed.count() << "s\tGames/sec: " << ( static_cast< double >( summary.m_games ) / elapsed.count() )
+		<< "\tRounds/sec: " << ( static_cast< double >( summary.m_rounds ) / elapsed.count() ) << std::endl;
+
+	return 0;
+}
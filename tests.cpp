@@ -1,8 +1,15 @@
 #include "Riichi.hpp"
 
+#include "riichi/AIAgents_Standard.hpp"
+#include "riichi/HandEvaluationCache.hpp"
+#include "riichi/HandInterpreter_Standard.hpp"
+#include "riichi/Payments_Standard.hpp"
 #include "riichi/Random.hpp"
 #include "riichi/Round.hpp"
 #include "riichi/Rules_Standard.hpp"
+#include "riichi/Shanten.hpp"
+#include "riichi/Simulator.hpp"
+#include "riichi/TileCountKernels.hpp"
 #include "riichi/Yaku_Standard.hpp"
 
 void TestYaku()
@@ -392,6 +399,57 @@ void TestYaku()
 		riEnsure( success, "Ikkitsuukan failed!" );
 	}
 
+	// ChuurenPoutou
+	{
+		Hand failHand;
+		failHand.AddFreeTiles( {
+			TileInstance{ { Suit::Manzu, Face::One }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::One }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::One }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Two }, generateID(), },
+			TileInstance{ { Suit::Pinzu, Face::Three }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Four }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Five }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Six }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Seven }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Eight }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Nine }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Nine }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Nine }, generateID(), },
+			} );
+
+		bool const fail = fnTestForYaku(
+			StandardYaku::ChuurenPoutou(),
+			failHand,
+			{ TileInstance{ { Suit::Manzu, Face::Three }, generateID(), }, TileDrawType::SelfDraw }
+		);
+		riEnsure( !fail, "ChuurenPoutou failed!" );
+
+		Hand successHand;
+		successHand.AddFreeTiles( {
+			TileInstance{ { Suit::Manzu, Face::One }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::One }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::One }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Two }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Three }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Four }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Five }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Six }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Seven }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Eight }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Nine }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Nine }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Nine }, generateID(), },
+			} );
+
+		bool const success = fnTestForYaku(
+			StandardYaku::ChuurenPoutou(),
+			successHand,
+			{ TileInstance{ { Suit::Manzu, Face::Five }, generateID(), }, TileDrawType::SelfDraw }
+		);
+		riEnsure( success, "ChuurenPoutou failed!" );
+	}
+
 	// TODO-TEST: Toitoi
 	// TODO-TEST: Sanankou
 	// TODO-TEST: SanshokuDoukou
@@ -411,15 +469,937 @@ void TestYaku()
 	// TODO-TEST: Tsuuiisou
 	// TODO-TEST: Chinroutou
 	// TODO-TEST: Ryuuiisou
-	// TODO-TEST: ChuurenPoutou
 	// TODO-TEST: Suukantsu
 	// TODO-TEST: Tenhou
 	// TODO-TEST: Chihou
 }
 
+void TestShanten()
+{
+	using namespace Riichi;
+
+	TileInstanceIDGenerator generateID;
+
+	// Standard
+	{
+		Hand hand;
+		hand.AddFreeTiles( {
+			TileInstance{ { Suit::Manzu, Face::One }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Two }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Three }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Nine }, generateID(), },
+			TileInstance{ { Suit::Manzu, Face::Nine }, generateID(), },
+			TileInstance{ { Suit::Pinzu, Face::One }, generateID(), },
+			TileInstance{ { Suit::Pinzu, Face::Two }, generateID(), },
+			TileInstance{ { Suit::Pinzu, Face::Three }, generateID(), },
+			TileInstance{ { Suit::Pinzu, Face::Five }, generateID(), },
+			TileInstance{ { Suit::Pinzu, Face::Seven }, generateID(), },
+			TileInstance{ { Suit::Souzu, Face::Four }, generateID(), },
+			TileInstance{ { Suit::Souzu, Face::Eight }, generateID(), },
+			TileInstance{ Face::East, generateID(), },
+			} );
+		riEnsure( Shanten( hand ) == 2, "Standard shanten failed!" );
+
+		TileCounts counts = hand.FreeTileCounts();
+		counts.Remove( TileKind{ Face::East } );
+		counts.Add( TileKind{ Suit::Pinzu, Face::Six } );
+		riEnsure( Shanten( counts, 0 ) == 1, "Standard shanten failed!" );
+		counts.Remove( TileKind{ Suit::Souzu, Face::Eight } );
+		counts.Add( TileKind{ Suit::Souzu, Face::Five } );
+		riEnsure( Shanten( counts, 0 ) == 0, "Standard shanten failed!" );
+		counts.Add( TileKind{ Suit::Souzu, Face::Three } );
+		riEnsure( Shanten( counts, 0 ) == -1, "Standard shanten failed!" );
+	}
+
+	// SevenPairs
+	{
+		TileCounts counts;
+		for ( Face face : { Face::One, Face::Three, Face::Five, Face::Seven, Face::Nine, Face::Two } )
+		{
+			counts.Add( TileKind{ Suit::Souzu, face }, 2 );
+		}
+		counts.Add( TileKind{ Face::Chun } );
+		riEnsure( Shanten( counts, 0, ShantenForm::SevenPairs ) == 0, "SevenPairs shanten failed!" );
+		riEnsure( Shanten( counts, 1, ShantenForm::SevenPairs ) == c_impossibleShanten, "SevenPairs shanten failed!" );
+
+		// Four of a kind can't be two pairs
+		counts.Remove( TileKind{ Suit::Souzu, Face::Two }, 2 );
+		counts.Add( TileKind{ Suit::Souzu, Face::One }, 2 );
+		riEnsure( Shanten( counts, 0, ShantenForm::SevenPairs ) == 2, "SevenPairs shanten failed!" );
+	}
+
+	// ThirteenOrphans
+	{
+		TileCounts counts;
+		for ( size_t kindI = 0; kindI < TileKindIndex::c_count; ++kindI )
+		{
+			if ( TileKindIndex{ kindI }.IsHonourOrTerminal() )
+			{
+				counts.Add( TileKindIndex{ kindI }.Kind() );
+			}
+		}
+		riEnsure( Shanten( counts, 0, ShantenForm::ThirteenOrphans ) == 0, "ThirteenOrphans shanten failed!" );
+		counts.Add( TileKind{ Face::North } );
+		riEnsure( Shanten( counts, 0 ) == -1, "ThirteenOrphans shanten failed!" );
+	}
+
+	// Discard ranking
+	{
+		TileCounts counts;
+		for ( Face face : { Face::Two, Face::Three, Face::Four } ) { counts.Add( TileKind{ Suit::Manzu, face } ); }
+		for ( Face face : { Face::Three, Face::Four, Face::Five, Face::Six, Face::Seven } ) { counts.Add( TileKind{ Suit::Pinzu, face } ); }
+		for ( Face face : { Face::Five, Face::Five, Face::Six, Face::Seven, Face::Eight, Face::Eight } ) { counts.Add( TileKind{ Suit::Souzu, face } ); }
+
+		Vector<DiscardOption> const ranked = RankDiscards( counts, 0, counts );
+		riEnsure( ranked.size() == counts.DistinctKinds(), "Discard ranking failed!" );
+		TileKindIndex const fiveSouzu = TileKind( Suit::Souzu, Face::Five );
+		TileKindIndex const eightSouzu = TileKind( Suit::Souzu, Face::Eight );
+		riEnsure( ranked[ 0 ].m_discard == fiveSouzu && ranked[ 1 ].m_discard == eightSouzu, "Discard ranking failed!" );
+		riEnsure( ranked[ 0 ].m_shanten == 0 && ranked[ 0 ].m_accepted.Size() == 3 && ranked[ 0 ].AcceptedLiveTotal() == 11, "Discard ranking failed!" );
+		riEnsure( ranked[ 2 ].m_shanten == 1, "Discard ranking failed!" );
+	}
+
+	// Discard ranking should agree with trying every discard then every draw, on random hands with and without melds,
+	// as well as hands shaped towards seven pairs or thirteen orphans
+	{
+		ShuffleRNG rng( 0 );
+		std::uniform_int_distribution<size_t> kindDist( 0, TileKindIndex::c_count - 1u );
+		std::uniform_int_distribution<size_t> crowdedDist( 0, 8u );
+		Vector<TileKindIndex> orphans;
+		for ( size_t kindI = 0; kindI < TileKindIndex::c_count; ++kindI )
+		{
+			if ( TileKindIndex{ kindI }.IsHonourOrTerminal() )
+			{
+				orphans.push_back( TileKindIndex{ kindI } );
+			}
+		}
+
+		for ( size_t handI = 0; handI < 600; ++handI )
+		{
+			size_t const shape = handI % 4u;
+			size_t const meldCount = shape == 0u ? handI / 4u % 4u : 0u;
+			size_t const tileCount = 14u - 3u * meldCount;
+
+			TileCounts counts;
+			auto fnTryAdd = [ & ]( TileKindIndex i_kind, uint8_t i_count )
+			{
+				if ( counts.Total() + i_count <= tileCount && counts[ i_kind ] + i_count <= 4u )
+				{
+					counts.Add( i_kind.Kind(), i_count );
+				}
+			};
+			if ( shape == 1u )
+			{
+				// Crowded into a single suit, where most standard shapes turn up
+				size_t const suitStart = Numbers::Count() * ( handI / 4u % Suits::Count() );
+				while ( counts.Total() < tileCount )
+				{
+					fnTryAdd( TileKindIndex{ suitStart + crowdedDist( rng ) }, 1 );
+				}
+			}
+			else if ( shape == 2u )
+			{
+				while ( counts.Total() < 12u )
+				{
+					fnTryAdd( TileKindIndex{ kindDist( rng ) }, 2 );
+				}
+			}
+			else if ( shape == 3u )
+			{
+				std::ranges::shuffle( orphans, rng );
+				for ( size_t orphanI = 0; orphanI < 11u + handI / 4u % 3u; ++orphanI )
+				{
+					fnTryAdd( orphans[ orphanI ], 1 );
+				}
+			}
+			while ( counts.Total() < tileCount )
+			{
+				fnTryAdd( TileKindIndex{ kindDist( rng ) }, 1 );
+			}
+
+			// Some of the rest of the wall has been seen too
+			TileCounts visible = counts;
+			for ( size_t seenI = 0; seenI < handI % 20u; ++seenI )
+			{
+				TileKindIndex const kind{ kindDist( rng ) };
+				if ( visible[ kind ] < 4u )
+				{
+					visible.Add( kind.Kind() );
+				}
+			}
+
+			Vector<DiscardOption> const ranked = RankDiscards( counts, meldCount, visible );
+			riEnsure( ranked.size() == counts.DistinctKinds(), "Discard ranking failed!" );
+			for ( DiscardOption const& option : ranked )
+			{
+				TileCounts remaining = counts;
+				remaining.Remove( option.m_discard.Kind() );
+				int const shanten = Shanten( remaining, meldCount );
+
+				TileKindSet accepted;
+				TileCounts acceptedLive;
+				for ( size_t drawI = 0; drawI < TileKindIndex::c_count; ++drawI )
+				{
+					TileKindIndex const draw{ drawI };
+					if ( remaining[ draw ] >= 4u )
+					{
+						continue;
+					}
+					TileCounts afterDraw = remaining;
+					afterDraw.Add( draw.Kind() );
+					if ( Shanten( afterDraw, meldCount ) < shanten )
+					{
+						accepted.Insert( draw );
+						acceptedLive.Add( draw.Kind(), static_cast< uint8_t >( 4u - visible[ draw ] ) );
+					}
+				}
+
+				riEnsure( option.m_shanten == shanten && option.m_accepted == accepted && option.m_acceptedLive == acceptedLive, "Discard ranking failed!" );
+			}
+		}
+	}
+}
+
+void TestInterpreters()
+{
+	using namespace Riichi;
+
+	// Decomposition tables should agree with the recursive search, other than not repeating interpretations
+	StandardInterpreter const recursive( StandardInterpreter::Mode::Recursive );
+	StandardInterpreter const tables( StandardInterpreter::Mode::DecompositionTables );
+	HandInterpretation const fixedPart;
+
+	// Each interpretation as its sorted groups, ungrouped tiles and waits, so the order groups were found in doesn't matter
+	auto fnInterpretationSet = [ & ]( StandardInterpreter const& i_interpreter, TileCounts const& i_counts )
+	{
+		Vector<Vector<uint64_t>> interpSet;
+		for ( HandInterpretation const& interp : static_cast< HandInterpreter const& >( i_interpreter ).GenerateInterpretations( fixedPart, i_counts ) )
+		{
+			Vector<uint64_t> groups;
+			for ( HandGroup const& group : interp.m_groups )
+			{
+				uint64_t groupKey = static_cast< uint64_t >( group.Type() );
+				for ( Tile const& tile : group.Tiles() )
+				{
+					groupKey = groupKey * 64u + TileKindIndex{ tile } + 1u;
+				}
+				groups.push_back( groupKey );
+			}
+			std::ranges::sort( groups );
+
+			Vector<uint64_t> ungrouped;
+			for ( Tile const& tile : interp.m_ungrouped )
+			{
+				ungrouped.push_back( TileKindIndex{ tile } );
+			}
+			std::ranges::sort( ungrouped );
+
+			Vector<uint64_t>& canonical = interpSet.emplace_back( std::move( groups ) );
+			canonical.push_back( UINT64_MAX );
+			canonical.insert( canonical.end(), ungrouped.begin(), ungrouped.end() );
+			canonical.push_back( UINT64_MAX );
+			for ( TileKind kind : interp.m_waits )
+			{
+				canonical.push_back( TileKindIndex{ kind } );
+			}
+			canonical.push_back( static_cast< uint64_t >( interp.m_waitType ) );
+		}
+		std::ranges::sort( interpSet );
+		interpSet.erase( std::ranges::unique( interpSet ).begin(), interpSet.end() );
+		return interpSet;
+	};
+
+	{
+		TileCounts nineGates;
+		for ( Face face : { Face::One, Face::One, Face::One, Face::Two, Face::Three, Face::Four, Face::Five, Face::Six, Face::Seven, Face::Eight, Face::Nine, Face::Nine, Face::Nine } )
+		{
+			nineGates.Add( TileKind{ Suit::Souzu, face } );
+		}
+
+		Vector<Vector<uint64_t>> const interpSet = fnInterpretationSet( recursive, nineGates );
+		riEnsure( interpSet.size() > Numbers::Count() && fnInterpretationSet( tables, nineGates ) == interpSet, "Decomposition tables failed!" );
+	}
+
+	// Random hands of every size the tables handle, drawn from all kinds, a single suit, or just a few neighbouring kinds to crowd the tiles together
+	ShuffleRNG rng( 0 );
+	for ( size_t handI = 0; handI < 40'000; ++handI )
+	{
+		size_t const kindCount = handI % 3u == 0u ? TileKindIndex::c_count : handI % 3u == 1u ? Numbers::Count() : 4u + handI % 3u;
+		size_t const firstKind = handI % 3u == 0u ? 0u : Numbers::Count() * ( handI / 3u % Suits::Count() ) + handI / 9u % ( Numbers::Count() - kindCount + 1u );
+		size_t const tileCount = 1u + 3u * ( handI % 5u );
+
+		TileCounts counts;
+		std::uniform_int_distribution<size_t> kindDist( firstKind, firstKind + kindCount - 1u );
+		while ( counts.Total() < tileCount )
+		{
+			TileKindIndex const kind{ kindDist( rng ) };
+			if ( counts[ kind ] < 4u )
+			{
+				counts.Add( kind.Kind() );
+			}
+		}
+
+		riEnsure( fnInterpretationSet( tables, counts ) == fnInterpretationSet( recursive, counts ), "Decomposition tables failed!" );
+	}
+}
+
+void TestTileKindSet()
+{
+	using namespace Riichi;
+
+	TileKindSet const ryanmen{ TileKind{ Suit::Manzu, Face::One }, TileKind{ Suit::Manzu, Face::Four } };
+	TileKindSet const kanchan{ TileKind{ Suit::Manzu, Face::Four } };
+	TileKindSet const honours{ TileKind{ Face::Chun }, TileKind{ Face::North }, TileKind{ Face::East } };
+
+	riEnsure( ryanmen.Size() == 2 && ryanmen.Contains( TileKind{ Suit::Manzu, Face::Four } ), "TileKindSet failed!" );
+	riEnsure( !ryanmen.Contains( TileKind{ Suit::Pinzu, Face::Four } ), "TileKindSet failed!" );
+	riEnsure( ryanmen.Intersects( kanchan ) && !ryanmen.Intersects( honours ), "TileKindSet failed!" );
+	riEnsure( ryanmen.ContainsAllOf( kanchan ) && ( ryanmen & kanchan ) == kanchan, "TileKindSet failed!" );
+	riEnsure( ( ryanmen | honours ).Size() == 5 && ( ryanmen - kanchan ).Size() == 1, "TileKindSet failed!" );
+
+	// Iterates in sorted order
+	Vector<TileKind> const iterated( honours.begin(), honours.end() );
+	riEnsure( std::is_sorted( iterated.begin(), iterated.end() ) && iterated.size() == 3 && iterated.front() == TileKind{ Face::Chun }, "TileKindSet failed!" );
+}
+
+void TestTileKindIndex()
+{
+	using namespace Riichi;
+
+	for ( size_t kindI = 0; kindI < TileKindIndex::c_count; ++kindI )
+	{
+		TileKindIndex const index{ kindI };
+		TileKind const kind = index.Kind();
+		riEnsure( TileKindIndex{ kind } == index, "TileKindIndex failed!" );
+		riEnsure( index.IsSimple() == kind.IsSimple() && index.IsHonourOrTerminal() == kind.IsHonourOrTerminal(), "TileKindIndex failed!" );
+		riEnsure( index.IsDragon() == kind.IsDragon() && index.IsWind() == kind.IsWind(), "TileKindIndex failed!" );
+		riEnsure( index.Next().Kind() == kind.Next() && index.Prev().Kind() == kind.Prev(), "TileKindIndex failed!" );
+	}
+}
+
+void TestCountKernels()
+{
+	using namespace Riichi;
+
+	// Every level the CPU has should agree with the scalar kernels
+	std::mt19937 rng( 0 );
+	std::uniform_int_distribution<int> countDistribution( 0, 3 );
+	CountKernelLevel const initialLevel = CountKernels::ActiveLevel();
+	for ( size_t trialI = 0; trialI < 100; ++trialI )
+	{
+		TileCounts a;
+		TileCounts b;
+		for ( size_t kindI = 0; kindI < TileKindIndex::c_count; ++kindI )
+		{
+			a.Add( TileKindIndex{ kindI }.Kind(), static_cast< uint8_t >( countDistribution( rng ) ) );
+			b.Add( TileKindIndex{ kindI }.Kind(), static_cast< uint8_t >( countDistribution( rng ) ) );
+		}
+
+		CountKernels::Use( CountKernelLevel::Scalar );
+		TileCounts expectedSum = a;
+		expectedSum.Add( b );
+		TileCounts expectedDifference = expectedSum;
+		expectedDifference.Remove( b );
+		riEnsure( expectedDifference == a, "Count kernels failed!" );
+		size_t const expectedMatches = a.CountMatches( b );
+		TileCounts const expectedRemaining = a.Remaining( 4 );
+		uint64_t const expectedMask = a.KindMask( 3 );
+
+		for ( CountKernelLevel level : { CountKernelLevel::SSE2, CountKernelLevel::AVX2 } )
+		{
+			if ( !CountKernels::Supported( level ) )
+			{
+				continue;
+			}
+			CountKernels::Use( level );
+			TileCounts sum = a;
+			sum.Add( b );
+			TileCounts difference = sum;
+			difference.Remove( b );
+			riEnsure( sum == expectedSum && difference == a, "Count kernels failed!" );
+			riEnsure( a.CountMatches( b ) == expectedMatches && a.Remaining( 4 ) == expectedRemaining && a.KindMask( 3 ) == expectedMask, "Count kernels failed!" );
+		}
+	}
+	CountKernels::Use( initialLevel );
+}
+
+void TestHandEvaluationCache()
+{
+	using namespace Riichi;
+
+	TileInstanceIDGenerator generateID;
+	Vector<PlayerID> mockPlayers{ PlayerID{}, PlayerID{}, PlayerID{}, PlayerID{} };
+	StandardYonma<Seat::East> mockRules;
+	ShuffleRNG mockRNG( 0 );
+	Round mockRound( Seat::East, mockPlayers, mockRules, mockRNG );
+
+	Vector<TileInstance> tiles{
+		TileInstance{ { Suit::Manzu, Face::Two }, generateID(), },
+		TileInstance{ { Suit::Manzu, Face::Three }, generateID(), },
+		TileInstance{ { Suit::Manzu, Face::Four }, generateID(), },
+		TileInstance{ { Suit::Pinzu, Face::Three }, generateID(), },
+		TileInstance{ { Suit::Pinzu, Face::Four }, generateID(), },
+		TileInstance{ { Suit::Pinzu, Face::Five }, generateID(), },
+		TileInstance{ { Suit::Pinzu, Face::Six }, generateID(), },
+		TileInstance{ { Suit::Pinzu, Face::Seven }, generateID(), },
+		TileInstance{ { Suit::Souzu, Face::Five }, generateID(), },
+		TileInstance{ { Suit::Souzu, Face::Five }, generateID(), },
+		TileInstance{ { Suit::Souzu, Face::Six }, generateID(), },
+		TileInstance{ { Suit::Souzu, Face::Seven }, generateID(), },
+		TileInstance{ { Suit::Souzu, Face::Eight, Akadora{} }, generateID(), },
+	};
+
+	// Keys only care about the tile values held
+	Hand hand;
+	hand.AddFreeTiles( tiles );
+	Hand reversedHand;
+	reversedHand.AddFreeTiles( tiles | std::views::reverse );
+	riEnsure( hand.Key() == reversedHand.Key(), "Hand key depends on tile order!" );
+
+	TileDraw const draw{ TileInstance{ { Suit::Souzu, Face::Eight }, generateID() }, TileDrawType::SelfDraw };
+	Hand otherHand = hand;
+	otherHand.Discard( tiles.back(), draw );
+	riEnsure( hand.Key() != otherHand.Key(), "Hand key ignores tile properties!" );
+	otherHand.Discard( draw.m_tile, TileDraw{ tiles.back(), TileDrawType::SelfDraw } );
+	riEnsure( hand.Key() == otherHand.Key(), "Hand key not restored!" );
+
+	// Cached results should match the rules exactly
+	HandEvaluationCache cache( 4 );
+	HandAssessment const assessment( hand, mockRules );
+	auto const [ waits, riichiDiscards ] = mockRules.WaitsWithYaku( mockRound, Seat::East, hand, assessment, draw, true );
+	for ( size_t i = 0; i < 2; ++i )
+	{
+		riEnsure( cache.Assessment( mockRules, reversedHand ).Waits() == assessment.Waits(), "Cached assessment differs!" );
+		auto const [ cachedWaits, cachedRiichiDiscards ] = cache.WaitsWithYaku( mockRules, mockRound, Seat::East, reversedHand, assessment, draw, true );
+		riEnsure( cachedWaits == waits, "Cached waits differ!" );
+		riEnsure( cachedRiichiDiscards.size() == riichiDiscards.size(), "Cached riichi discards differ!" );
+	}
+	riEnsure( cache.GetStats().m_assessmentHits == 1 && cache.GetStats().m_waitsHits == 1, "Cache didn't hit!" );
+	riEnsure( cache.GetStats().AssessmentHitRate() == 0.5, "Cache hit rate wrong!" );
+
+	// Entries belong to the rules that made them, not whatever rules the hand is next asked about
+	StandardYonma<Seat::East> const otherRules;
+	riEnsure( otherRules.ID() != mockRules.ID(), "Rules share an ID!" );
+	cache.Assessment( otherRules, hand );
+	cache.WaitsWithYaku( otherRules, mockRound, Seat::East, hand, assessment, draw, true );
+	riEnsure( cache.GetStats().m_assessmentMisses == 2 && cache.GetStats().m_waitsMisses == 2, "Cache hit for different rules!" );
+}
+
+void TestRiichiDiscards()
+{
+	using namespace Riichi;
+
+	TileInstanceIDGenerator generateID;
+	Vector<PlayerID> mockPlayers{ PlayerID{}, PlayerID{}, PlayerID{}, PlayerID{} };
+	StandardYonma<Seat::East> mockRules;
+	ShuffleRNG mockRNG( 0 );
+	Round mockRound( Seat::East, mockPlayers, mockRules, mockRNG );
+
+	Hand hand;
+	hand.AddFreeTiles( {
+		TileInstance{ { Suit::Manzu, Face::Two }, generateID(), },
+		TileInstance{ { Suit::Manzu, Face::Three }, generateID(), },
+		TileInstance{ { Suit::Manzu, Face::Four }, generateID(), },
+		TileInstance{ { Suit::Pinzu, Face::Three }, generateID(), },
+		TileInstance{ { Suit::Pinzu, Face::Four }, generateID(), },
+		TileInstance{ { Suit::Pinzu, Face::Five }, generateID(), },
+		TileInstance{ { Suit::Pinzu, Face::Six }, generateID(), },
+		TileInstance{ { Suit::Pinzu, Face::Seven }, generateID(), },
+		TileInstance{ { Suit::Souzu, Face::Five }, generateID(), },
+		TileInstance{ { Suit::Souzu, Face::Five }, generateID(), },
+		TileInstance{ { Suit::Souzu, Face::Six }, generateID(), },
+		TileInstance{ { Suit::Souzu, Face::Seven }, generateID(), },
+		TileInstance{ { Suit::Souzu, Face::Eight }, generateID(), },
+		} );
+	TileDraw const draw{ TileInstance{ { Suit::Souzu, Face::Eight }, generateID() }, TileDrawType::SelfDraw };
+
+	// Either 5s or 8s leaves the 2-5-8p wait, nothing else leaves the hand in tenpai
+	TileKindSet expectedWaits;
+	expectedWaits.Insert( TileKind{ Suit::Pinzu, Face::Two } );
+	expectedWaits.Insert( TileKind{ Suit::Pinzu, Face::Five } );
+	expectedWaits.Insert( TileKind{ Suit::Pinzu, Face::Eight } );
+
+	Vector<RiichiDiscard> const discards = mockRules.RiichiDiscards( mockRound, Seat::East, hand, HandAssessment( hand, mockRules ), draw );
+	riEnsure( discards.size() == 4, "Riichi discards failed!" );
+	riEnsure( discards.back().m_tile.ID() == draw.m_tile.ID(), "Riichi discards failed!" );
+	riEnsure( std::ranges::all_of( discards, [ & ]( RiichiDiscard const& i_discard ) { return i_discard.m_waits == expectedWaits; } ), "Riichi discards failed!" );
+
+	// The shared pass should find the same waits as assessing each discard, on complete hands with one tile swapped.
+	// Seven pairs shapes are in there too, which shouldn't give any waits the standard interpreter wouldn't.
+	ShuffleRNG rng( 0 );
+	std::uniform_int_distribution<size_t> kindDist( 0, TileKindIndex::c_count - 1u );
+	std::uniform_int_distribution<size_t> runDist( 0, Suits::Count() * ( Numbers::Count() - 2u ) - 1u );
+	Hand const noMelds;
+	for ( size_t handI = 0; handI < 2'000; ++handI )
+	{
+		TileCounts counts;
+		auto fnTryAdd = [ & ]( TileKindIndex i_kind, uint8_t i_count )
+		{
+			if ( counts[ i_kind ] + i_count <= 3u )
+			{
+				counts.Add( i_kind.Kind(), i_count );
+			}
+		};
+		if ( handI % 4u == 3u )
+		{
+			while ( counts.Total() < 14u )
+			{
+				TileKindIndex const kind{ kindDist( rng ) };
+				if ( counts[ kind ] == 0u )
+				{
+					counts.Add( kind.Kind(), 2 );
+				}
+			}
+		}
+		else
+		{
+			while ( counts.Total() < 12u )
+			{
+				if ( rng() % 2u == 0u )
+				{
+					fnTryAdd( TileKindIndex{ kindDist( rng ) }, 3 );
+				}
+				else
+				{
+					size_t const run = runDist( rng );
+					size_t const first = run / ( Numbers::Count() - 2u ) * Numbers::Count() + run % ( Numbers::Count() - 2u );
+					if ( counts[ TileKindIndex{ first } ] < 3u && counts[ TileKindIndex{ first + 1u } ] < 3u && counts[ TileKindIndex{ first + 2u } ] < 3u )
+					{
+						for ( size_t kindI = first; kindI < first + 3u; ++kindI )
+						{
+							counts.Add( TileKindIndex{ kindI }.Kind() );
+						}
+					}
+				}
+			}
+			while ( counts.Total() < 14u )
+			{
+				fnTryAdd( TileKindIndex{ kindDist( rng ) }, 2 );
+			}
+		}
+
+		TileKindIndex swappedOut{ kindDist( rng ) };
+		while ( counts[ swappedOut ] == 0u )
+		{
+			swappedOut = TileKindIndex{ kindDist( rng ) };
+		}
+		counts.Remove( swappedOut.Kind() );
+		TileKindIndex const swappedIn{ kindDist( rng ) };
+		counts.Add( swappedIn.Kind() );
+		if ( counts.KindMask( 4 ) != 0 )
+		{
+			continue;
+		}
+
+		Array<TileKindSet, TileKindIndex::c_count> const sharedWaits = WaitsAfterDiscards( counts, 0 );
+		for ( size_t kindI = 0; kindI < TileKindIndex::c_count; ++kindI )
+		{
+			TileKindIndex const kind{ kindI };
+			if ( counts[ kind ] == 0u )
+			{
+				riEnsure( sharedWaits[ kind ].Empty(), "Riichi discard waits failed!" );
+				continue;
+			}
+			TileCounts remaining = counts;
+			remaining.Remove( kind.Kind() );
+			riEnsure( sharedWaits[ kind ] == HandAssessment( noMelds, remaining, mockRules ).Waits(), "Riichi discard waits failed!" );
+		}
+	}
+}
+
+void TestPayments()
+{
+	using namespace Riichi;
+
+	StandardYonma<Seat::East> mockRules;
+
+	// Payments from the rules should be read straight from the table
+	HandScore const handScore{ 0, 32, { { YakuID{ 1 }, 1 }, { YakuID{ 9 }, 1 } } };
+	riEnsure( std::strcmp( mockRules.YakuName( YakuID{ 1 } ), "Riichi" ) == 0 && handScore.HanTotal() == 2, "Yaku IDs failed!" );
+	StandardPayments::Payment const& tsumo = StandardPayments::Lookup( 2, 40, false, true );
+	riEnsure( tsumo.m_fromDealer == 1300 && tsumo.m_fromNonDealer == 700 && tsumo.m_total == 2700, "Payment table failed!" );
+	TablePayments const tsumoPayments = mockRules.TsumoPayments( handScore, Seat::South );
+	riEnsure( tsumoPayments.m_pointsPerSeat[ Seat::South ] == tsumo.m_total && tsumoPayments.m_pointsPerSeat[ Seat::East ] == -tsumo.m_fromDealer && tsumoPayments.m_pointsPerSeat[ Seat::West ] == -tsumo.m_fromNonDealer, "Tsumo payments failed!" );
+	TablePayments const ronPayments = mockRules.RonPayments( handScore, Seat::East, Seat::North );
+	riEnsure( ronPayments.m_pointsPerSeat[ Seat::East ] == 3900 && ronPayments.m_pointsPerSeat[ Seat::North ] == -3900, "Ron payments failed!" );
+
+	// Fu past the end of the table is already mangan
+	riEnsure( StandardPayments::Lookup( 1, 110, false, false ).m_total == 3600, "Payment table failed!" );
+	riEnsure( StandardPayments::Lookup( 1, 270, false, false ).m_total == 8000, "Payment table failed!" );
+}
+
+void TestSimulator()
+{
+	using namespace Riichi;
+
+	struct Recorder : SimulationSummary
+	{
+		Vector<GameResult> m_results;
+		void Add( GameResult const& i_result ) override { SimulationSummary::Add( i_result ); m_results.push_back( i_result ); }
+	};
+
+	Simulator::Config config;
+	config.m_tableCount = 6;
+	config.m_masterSeed = 1234;
+	config.m_rules = std::make_shared<StandardYonma<Seat::East>>();
+	config.m_makePlayers = []( size_t i_tableIndex )
+	{
+		Vector<Player> players;
+		players.emplace_back( std::make_unique<AI::GhostAgent>() );
+		players.emplace_back( std::make_unique<AI::GhostAgent>() );
+		players.emplace_back( std::make_unique<AI::ButtonMasherAgent>() );
+		players.emplace_back( std::make_unique<AI::ButtonMasherAgent>() );
+		return players;
+	};
+
+	// Results shouldn't depend on the number of threads, or on playing a table alone
+	config.m_threadCount = 1;
+	Recorder singleThreaded;
+	Simulator( config ).Run( singleThreaded );
+	config.m_threadCount = 3;
+	Recorder multiThreaded;
+	Simulator( config ).Run( multiThreaded );
+
+	riEnsure( singleThreaded.m_games == 6 && singleThreaded.m_rounds >= 6, "Simulator failed!" );
+	riEnsure( singleThreaded.m_results == multiThreaded.m_results && singleThreaded.m_digest == multiThreaded.m_digest, "Simulator results depend on thread count!" );
+	riEnsure( Simulator( config ).PlayTable( 4 ) == singleThreaded.m_results[ 4 ], "Simulator table not replayable!" );
+	riEnsure( Simulator::TableSeeds( 1234, 4 ) != Simulator::TableSeeds( 1234, 5 ), "Simulator seeds repeat!" );
+}
+
+void TestTableFork()
+{
+	using namespace Riichi;
+
+	std::shared_ptr<Rules const> const rules = std::make_shared<StandardYonma<Seat::East>>();
+	auto fnMakeTable = [ & ]()
+	{
+		std::unique_ptr<Table> table = std::make_unique<Table>( rules, 42, 43 );
+		for ( size_t playerI = 0; playerI < 4; ++playerI )
+		{
+			table->AddPlayer( Player{ std::make_unique<AI::ButtonMasherAgent>() } );
+		}
+		return table;
+	};
+	auto fnStep = []( Table& io_table )
+	{
+		io_table.AdvanceAIOnly();
+		io_table.RetrieveEvent();
+	};
+	auto fnFinish = [ & ]( Table& io_table )
+	{
+		while ( io_table.GetState().Type() != TableStateType::GameOver )
+		{
+			fnStep( io_table );
+		}
+		Vector<Points> points;
+		for ( auto const& [ player, playerPoints ] : io_table.AllPlayers() )
+		{
+			points.push_back( playerPoints );
+		}
+		return points;
+	};
+
+	Vector<Points> const expected = fnFinish( *fnMakeTable() );
+
+	// A fork should play out the same as the table it came from, without disturbing it
+	std::unique_ptr<Table> table = fnMakeTable();
+	for ( size_t stepI = 0; stepI < 500; ++stepI )
+	{
+		fnStep( *table );
+	}
+	table->EnableEvaluationCache( 1024 );
+	std::unique_ptr<Table> const fork = table->Fork();
+	riEnsure( fork->GetEvaluationCache() && fork->GetEvaluationCache() != table->GetEvaluationCache(), "Forked table should have its own cache!" );
+	riEnsure( &fork->GetRules() == &table->GetRules(), "Forked table doesn't share rules!" );
+	// Finished rounds are shared rather than copied, but the round in play is the fork's own
+	riEnsure( &table->GetRound( 0 ) != &table->GetRound(), "Expected a finished round by now" );
+	riEnsure( &fork->GetRound( 0 ) == &table->GetRound( 0 ) && &fork->GetRound() != &table->GetRound(), "Forked table copied the wrong rounds!" );
+	riEnsure( fnFinish( *fork ) == expected, "Forked table played differently!" );
+	riEnsure( fnFinish( *table ) == expected, "Forking disturbed the table!" );
+
+	// Agents that don't opt in to cloning make for a null fork, rather than anything going wrong
+	struct UncloneableAgent
+		: AI::ButtonMasherAgent
+	{
+		std::unique_ptr<AI::Agent> Clone() const override { return AI::Agent::Clone(); }
+	};
+	Table uncloneable( rules, 42, 43 );
+	for ( size_t playerI = 0; playerI < 3; ++playerI )
+	{
+		uncloneable.AddPlayer( Player{ std::make_unique<AI::ButtonMasherAgent>() } );
+	}
+	uncloneable.AddPlayer( Player{ std::make_unique<UncloneableAgent>() } );
+	riEnsure( !uncloneable.Fork(), "Forked a table with an agent that can't be cloned!" );
+}
+
+void TestRoundUndo()
+{
+	using namespace Riichi;
+
+	Vector<PlayerID> mockPlayers{ PlayerID{}, PlayerID{}, PlayerID{}, PlayerID{} };
+	StandardYonma<Seat::East> mockRules;
+	// Kans are rare enough that it takes a few rounds to see every action
+	for ( unsigned int seed = 0; seed < 64; ++seed )
+	{
+		ShuffleRNG mockRNG( seed );
+		Round round( Seat::East, mockPlayers, mockRules, mockRNG );
+		round.DealHands();
+
+		// Everything an action can change, down to the order of free tiles
+		auto fnSnapshot = [ & ]()
+		{
+			Vector<uint64_t> snapshot{ ( uint64_t )round.CurrentTurn(), round.WallTilesRemaining(), round.DeadWallDrawsRemaining(), round.RiichiSticks() };
+			for ( TileInstance const& tile : round.GetDoraIndicatorTiles( true ) )
+			{
+				snapshot.push_back( tile.ID().GetValue() );
+			}
+			for ( Seat seat : round.Seats() )
+			{
+				Hand const& hand = round.CurrentHand( seat );
+				snapshot.push_back( hand.Key() );
+				snapshot.push_back( hand.Melds().size() );
+				snapshot.push_back( round.CurrentTileDraw( seat ) ? round.CurrentTileDraw( seat )->m_tile.ID().GetValue() : 0u );
+				snapshot.push_back( round.CalledRiichi( seat ) + 2u * round.RiichiIppatsuValid( seat ) + 4u * round.WaitingToPayRiichiBet( seat ) + 8u * round.Furiten( seat, TileKindSet{} ) );
+				// Hands are only assessed while waiting, not between a chi or pon and its discard
+				if ( hand.FreeTiles().size() % 3u == 1u )
+				{
+					snapshot.push_back( round.CurrentHandAssessment( seat ).Waits().Size() );
+					// Undoing should hand back the very assessment the hand had, rather than build it again
+					snapshot.push_back( reinterpret_cast< uintptr_t >( round.CurrentHandAssessment( seat ).Interpretations().data() ) );
+				}
+				for ( TileInstance const& tile : hand.FreeTiles() )
+				{
+					snapshot.push_back( tile.ID().GetValue() );
+				}
+				for ( TileInstance const& tile : round.VisibleDiscards( seat ).first )
+				{
+					snapshot.push_back( tile.ID().GetValue() );
+				}
+				for ( size_t kindI = 0; kindI < TileKindIndex::c_count; ++kindI )
+				{
+					TileKindSet discardedKind;
+					discardedKind.Insert( TileKindIndex{ kindI } );
+					snapshot.push_back( round.Furiten( seat, discardedKind ) );
+				}
+			}
+			return snapshot;
+		};
+
+		// Play out a line with a bit of everything in it, snapshotting before each action
+		round.StartJournal( 256 );
+		Vector<Vector<uint64_t>> snapshots;
+		auto fnAct = [ & ]( auto&& i_fnAction )
+		{
+			snapshots.push_back( fnSnapshot() );
+			i_fnAction();
+			riEnsure( round.JournalledActions() == snapshots.size(), "Every action should be journalled once" );
+		};
+
+		for ( size_t turnI = 0; round.WallTilesRemaining() > 0u; ++turnI )
+		{
+			Seat const seat = round.CurrentTurn();
+			Option<TileDraw> const draw = round.CurrentTileDraw( seat );
+			Vector<HandKanOption> const handKans = round.CurrentHand( seat ).HandKanOptions( draw ? Option<TileInstance>( draw->m_tile ) : std::nullopt );
+			if ( draw && !handKans.empty() && round.WallTilesRemaining() > 0u && round.DeadWallDrawsRemaining() > 0u )
+			{
+				fnAct( [ & ] { round.HandKan( handKans[ turnI % handKans.size() ] ); } );
+				fnAct( [ & ] { round.HandKanRonPass(); } );
+				continue;
+			}
+
+			Option<TileInstance> const toDiscard = ( draw && turnI % 2u == 0u ) ? Option<TileInstance>() : Option<TileInstance>( round.CurrentHand( seat ).FreeTiles()[ turnI % round.CurrentHand( seat ).FreeTiles().size() ] );
+			if ( turnI == 5u )
+			{
+				fnAct( [ & ] { round.Riichi( toDiscard ); } );
+			}
+			else if ( round.CalledRiichi( seat ) )
+			{
+				fnAct( [ & ] { round.Discard( std::nullopt ); } );
+			}
+			else
+			{
+				fnAct( [ & ] { round.Discard( toDiscard ); } );
+			}
+
+			// Call the discard if anybody can, otherwise pass with someone taking furiten
+			TileKind const discardKind = round.Discards( seat ).back().Tile().Kind();
+			Seat const next = NextPlayer( seat, mockPlayers.size() );
+			bool called = false;
+			for ( Seat caller : round.Seats() )
+			{
+				if ( caller == seat || round.CalledRiichi( caller ) )
+				{
+					continue;
+				}
+				Hand const& hand = round.CurrentHand( caller );
+				if ( Vector<KanOption> const kans = hand.KanOptions( discardKind ); !kans.empty() && round.DeadWallDrawsRemaining() > 0u && round.WallTilesRemaining() > 0u )
+				{
+					fnAct( [ & ] { round.DiscardKan( caller, kans.front() ); } );
+				}
+				else if ( Vector<PonOption> const pons = hand.PonOptions( discardKind ); !pons.empty() )
+				{
+					fnAct( [ & ] { round.Pon( caller, pons.back() ); } );
+				}
+				else if ( Vector<ChiOption> const chis = hand.ChiOptions( discardKind ); caller == next && !chis.empty() && turnI % 3u == 0u )
+				{
+					fnAct( [ & ] { round.Chi( caller, chis.front() ); } );
+				}
+				else
+				{
+					continue;
+				}
+				called = true;
+				break;
+			}
+			if ( !called )
+			{
+				fnAct( [ & ] { round.PassCalls( turnI % 4u == 1u ? SeatSet{ next } : SeatSet{} ); } );
+			}
+		}
+
+		// Then take it all back, one action at a time
+		riEnsure( snapshots.size() > 100u, "Expected a longer line of play" );
+		while ( round.JournalledActions() > 0u )
+		{
+			round.Undo();
+			riEnsure( fnSnapshot() == snapshots[ round.JournalledActions() ], "Undo didn't restore the round!" );
+		}
+		round.StopJournal();
+	}
+
+	// Quads made purely from free tiles are too rare to rely on seeing above
+	TileInstanceIDGenerator generateID;
+	Vector<TileInstance> fours;
+	for ( size_t i = 0; i < 4; ++i )
+	{
+		fours.push_back( TileInstance{ { Suit::Pinzu, Face::Four }, generateID() } );
+	}
+	Hand hand;
+	hand.AddFreeTiles( fours );
+	hand.AddFreeTiles( { TileInstance{ { Suit::Manzu, Face::One }, generateID() }, TileInstance{ { Suit::Manzu, Face::One }, generateID() }, TileInstance{ { Suit::Manzu, Face::One }, generateID() } } );
+	hand.CallMeld( TileInstance{ { Suit::Manzu, Face::One }, generateID() }, Seat::North, hand.FreeTiles()[ 0 ], hand.FreeTiles()[ 1 ] );
+
+	Hand const before = hand;
+	riEnsure( hand.HandKanOptions( std::nullopt ).size() == 2, "Expected a closed and an upgraded quad" );
+	for ( HandKanOption const& kanOption : hand.HandKanOptions( std::nullopt ) )
+	{
+		Hand::FreeTileIndices const from = hand.FindFreeTiles( kanOption.m_freeHandTilesInvolved );
+		hand.CallMeldFromHand( kanOption );
+		if ( kanOption.m_closed )
+		{
+			hand.UndoMeld( from );
+		}
+		else
+		{
+			hand.UndoUpgradedQuad( kanOption.m_freeHandTilesInvolved.front(), from );
+		}
+		riEnsure( hand.Key() == before.Key() && hand.Melds().size() == before.Melds().size()
+			&& std::ranges::equal( hand.FreeTiles(), before.FreeTiles(), {}, &TileInstance::GetID, &TileInstance::GetID ),
+			"Undoing a quad didn't restore the hand!" );
+	}
+}
+
+void TestKanNeedsReplacementTile()
+{
+	using namespace Riichi;
+
+	// Calls every kan (and pon, to set up upgraded quads) it can and never wins, so rounds run the wall and dead wall dry
+	struct KanCount
+	{
+		size_t m_kans{ 0 };
+		size_t m_lastTileTurns{ 0 };
+		size_t m_deadWallEmptyTurns{ 0 };
+	};
+	struct KanHungryAgent
+		: AI::Agent
+	{
+		KanCount* m_count;
+
+		explicit KanHungryAgent( KanCount& io_count ) : m_count{ &io_count } {}
+
+		AI::TurnDecisionData MakeTurnDecision( AI::DecisionToken, AIRNG&, Seat, Table const&, Round const& i_round, TableStates::Turn_AI const& i_turnData ) override
+		{
+			bool const noReplacementTile = i_round.WallTilesRemaining() == 0u || i_round.DeadWallDrawsRemaining() == 0u;
+			riEnsure( !noReplacementTile || !i_turnData.CanKan(), "Kan offered with no replacement tile to draw!" );
+			m_count->m_lastTileTurns += i_round.WallTilesRemaining() == 0u;
+			m_count->m_deadWallEmptyTurns += i_round.DeadWallDrawsRemaining() == 0u;
+
+			if ( i_turnData.CanKan() )
+			{
+				++m_count->m_kans;
+				return { AI::TurnDecisionData::Tag<AI::TurnDecision::Kan>(), i_turnData.KanOptions().front() };
+			}
+			if ( i_turnData.GetCurrentTileDraw() )
+			{
+				return { AI::TurnDecisionData::Tag<AI::TurnDecision::Discard>(), std::nullopt };
+			}
+			return { AI::TurnDecisionData::Tag<AI::TurnDecision::Discard>(), i_turnData.GetCurrentHand().FreeTiles().front() };
+		}
+
+		AI::BetweenTurnsDecisionData MakeBetweenTurnsDecision( AI::DecisionToken, AIRNG&, Seat i_agentSeat, Table const&, Round const& i_round, TableStates::BetweenTurns const& i_turnData ) override
+		{
+			bool const noReplacementTile = i_round.WallTilesRemaining() == 0u || i_round.DeadWallDrawsRemaining() == 0u;
+			riEnsure( !noReplacementTile || std::ranges::all_of( i_turnData.CanKan(), &Vector<KanOption>::empty ), "Kan offered on a discard with no replacement tile to draw!" );
+
+			if ( !i_turnData.CanKan()[ i_agentSeat ].empty() )
+			{
+				++m_count->m_kans;
+				return { AI::BetweenTurnsDecisionData::Tag<AI::BetweenTurnsDecision::Kan>(), i_turnData.CanKan()[ i_agentSeat ].front() };
+			}
+			if ( !i_turnData.CanPon()[ i_agentSeat ].empty() )
+			{
+				return { AI::BetweenTurnsDecisionData::Tag<AI::BetweenTurnsDecision::Pon>(), i_turnData.CanPon()[ i_agentSeat ].front() };
+			}
+			return { AI::BetweenTurnsDecisionData::Tag<AI::BetweenTurnsDecision::Pass>() };
+		}
+	};
+
+	// With a single replacement tile, one kan is enough to use up the dead wall
+	struct OneReplacementTileRules
+		: StandardYonma<Seat::East>
+	{
+		size_t DeadWallDrawsAvailable() const override { return 1u; }
+	};
+
+	std::shared_ptr<Rules const> const rules = std::make_shared<OneReplacementTileRules>();
+	KanCount count;
+	for ( unsigned int seed = 0; seed < 16; ++seed )
+	{
+		Table table( rules, seed, seed );
+		for ( size_t playerI = 0; playerI < 4; ++playerI )
+		{
+			table.AddPlayer( Player{ std::make_unique<KanHungryAgent>( count ) } );
+		}
+
+		// Just the first round: every one of them ends on the last tile of the wall
+		bool roundStarted = false;
+		while ( !roundStarted || table.GetState().Type() != TableStateType::BetweenRounds )
+		{
+			roundStarted |= table.GetState().Type() != TableStateType::Setup && table.GetState().Type() != TableStateType::BetweenRounds;
+			table.AdvanceAIOnly();
+			table.RetrieveEvent();
+		}
+	}
+	riEnsure( count.m_kans > 0u, "Expected some kans to be called" );
+	riEnsure( count.m_lastTileTurns > 0u, "Expected to reach the last tile of the wall" );
+	riEnsure( count.m_deadWallEmptyTurns > 0u, "Expected to use up the dead wall" );
+}
+
 int main()
 {
 	TestYaku();
+	TestShanten();
+	TestInterpreters();
+	TestTileKindSet();
+	TestTileKindIndex();
+	TestCountKernels();
+	TestHandEvaluationCache();
+	TestRiichiDiscards();
+	TestPayments();
+	TestSimulator();
+	TestTableFork();
+	TestRoundUndo();
+	TestKanNeedsReplacementTile();
 
 	return 0;
 }